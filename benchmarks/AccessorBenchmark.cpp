@@ -0,0 +1,128 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/config.h"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Cost (ns per call) of the Parameters accessors on model_a1_5.
+ *
+ * Usage: AccessorBenchmark [repetitions]
+ */
+
+using ROADEF12COMMON::Parameters;
+
+/**
+ * Times "repetitions" sweeps of the given accessor loop and prints
+ * the average cost of a single call.
+ */
+template <typename Sweep>
+void
+report ( const char* name, Sweep sweep, long callsPerSweep, int repetitions )
+{
+    long checksum = 0;
+
+    std::chrono::steady_clock::time_point start
+        = std::chrono::steady_clock::now();
+
+    for ( int i = 0 ; i < repetitions ; ++i )
+    {
+        checksum += sweep();
+    }
+
+    std::chrono::duration<double, std::nano> elapsed
+        = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::setw ( 22 ) << name << std::fixed
+              << std::setprecision ( 2 ) << std::setw ( 10 )
+              << elapsed.count() / ( double ( callsPerSweep ) * repetitions )
+              << " ns/call   (checksum " << checksum << ")" << std::endl;
+}
+
+int main ( int argc, char** argv )
+{
+    int repetitions = ( argc > 1 ) ? atoi ( argv[1] ) : 200;
+
+    std::string file = std::string ( PROJECT_SOURCE_DIR ) +
+                       "/roadef12-material/data/data_a1/model_a1_5.txt";
+
+    std::vector<int> values;
+    ROADEF12COMMON::FileParser::parseVector ( file.c_str(), values );
+
+    const Parameters params ( values );
+
+    const long P = params.processes.size();
+    const long M = params.machines.size();
+    const long R = params.resources.size();
+    const long B = params.costs.getNumObjectiveBalance();
+
+    report ( "getRequirement", [&] () {
+        long sum = 0;
+        for ( long p = 0 ; p < P ; ++p )
+            for ( long r = 0 ; r < R ; ++r )
+                sum += params.processes.getRequirement ( p, r );
+        return sum; }, P*R, repetitions );
+
+    report ( "getService/getPMC", [&] () {
+        long sum = 0;
+        for ( long p = 0 ; p < P ; ++p )
+            sum += params.processes.getService ( p ) +
+                   params.processes.getPMC ( p );
+        return sum; }, 2*P, repetitions );
+
+    report ( "getCapacity", [&] () {
+        long sum = 0;
+        for ( long m = 0 ; m < M ; ++m )
+            for ( long r = 0 ; r < R ; ++r )
+                sum += params.machines.getCapacity ( m, r ) +
+                       params.machines.getSafetyCapacity ( m, r );
+        return sum; }, 2*M*R, repetitions*100 );
+
+    report ( "getMovingCost", [&] () {
+        long sum = 0;
+        for ( long m = 0 ; m < M ; ++m )
+            for ( long n = 0 ; n < M ; ++n )
+                sum += params.machines.getMovingCost ( m, n );
+        return sum; }, M*M, repetitions*100 );
+
+    report ( "costs (balance, load)", [&] () {
+        long sum = 0;
+        for ( long b = 0 ; b < B ; ++b )
+            sum += params.costs.getObjectiveBalanceTarget ( b ) +
+                   params.costs.getBalanceCostWeight ( b );
+        for ( long r = 0 ; r < R ; ++r )
+            sum += params.costs.getLoadCostWeight ( r );
+        return sum; }, 2*B+R, repetitions*1000 );
+
+    return EXIT_SUCCESS;
+}
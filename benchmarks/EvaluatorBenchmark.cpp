@@ -0,0 +1,164 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/BatchEvaluator.hpp"
+#include "roadef12-common/config.h"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Full objective evaluations, shift deltas (one by one and batched) and
+ * swap deltas per second on the data_a1 instances.
+ *
+ * Usage: EvaluatorBenchmark [repetitions]
+ */
+int main ( int argc, char** argv )
+{
+    int repetitions = ( argc > 1 ) ? atoi ( argv[1] ) : 2000;
+
+    std::string dir = std::string ( PROJECT_SOURCE_DIR ) +
+                      "/roadef12-material/data/data_a1/";
+
+    for ( int instance = 1 ; instance <= 5 ; ++instance )
+    {
+        std::string id = boost::lexical_cast<std::string> ( instance );
+
+        std::vector<int> values;
+        ROADEF12COMMON::FileParser::parseVector
+            ( ( dir + "model_a1_" + id + ".txt" ).c_str(), values );
+
+        const ROADEF12COMMON::Parameters params ( values );
+        const ROADEF12COMMON::Assignment assignment
+            ( ( dir + "assignment_a1_" + id + ".txt" ).c_str(), params );
+
+        ROADEF12COMMON::Evaluator evaluator ( params );
+
+        int64_t checksum = 0;
+
+        std::chrono::steady_clock::time_point start
+            = std::chrono::steady_clock::now();
+
+        for ( int i = 0 ; i < repetitions ; ++i )
+        {
+            checksum += evaluator.evaluate ( assignment ).total();
+        }
+
+        std::chrono::duration<double> elapsed
+            = std::chrono::steady_clock::now() - start;
+
+        std::cout << "a1_" << id << std::fixed << std::setprecision ( 0 )
+                  << std::setw ( 14 ) << repetitions / elapsed.count()
+                  << " evals/s   (cost "
+                  << checksum / repetitions << ")" << std::endl;
+
+        // Shift deltas: every process to every machine
+        const uint P = params.processes.size();
+        const uint M = params.machines.size();
+        const int  sweeps = std::max ( 1, repetitions / 100 );
+
+        checksum = 0;
+        start    = std::chrono::steady_clock::now();
+
+        for ( int i = 0 ; i < sweeps ; ++i )
+        {
+            for ( uint p = 0 ; p < P ; ++p )
+            {
+                for ( uint m = 0 ; m < M ; ++m )
+                {
+                    checksum += evaluator.deltaShift ( assignment, p, m );
+                }
+            }
+        }
+
+        elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "   " << std::setw ( 14 )
+                  << double ( sweeps ) * P * M / elapsed.count()
+                  << " shift deltas/s (checksum " << checksum << ")"
+                  << std::endl;
+
+        // Same deltas, one batch per process
+        ROADEF12COMMON::BatchEvaluator batch ( params );
+        std::vector<int64_t> deltas ( M );
+
+        checksum = 0;
+        start    = std::chrono::steady_clock::now();
+
+        for ( int i = 0 ; i < sweeps ; ++i )
+        {
+            for ( uint p = 0 ; p < P ; ++p )
+            {
+                batch.evaluateMachines ( assignment, p, &deltas[0] );
+
+                for ( uint m = 0 ; m < M ; ++m )
+                {
+                    checksum += deltas [ m ];
+                }
+            }
+        }
+
+        elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "   " << std::setw ( 14 )
+                  << double ( sweeps ) * P * M / elapsed.count()
+                  << " batch deltas/s (checksum " << checksum << ")"
+                  << std::endl;
+
+        // Swap deltas: every process with M other processes
+        checksum = 0;
+        start    = std::chrono::steady_clock::now();
+
+        for ( int i = 0 ; i < sweeps ; ++i )
+        {
+            for ( uint p = 0 ; p < P ; ++p )
+            {
+                for ( uint q = 0 ; q < M ; ++q )
+                {
+                    checksum += evaluator.deltaSwap ( assignment, p,
+                                                      ( p + q*7919 ) % P );
+                }
+            }
+        }
+
+        elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "   " << std::setw ( 14 )
+                  << double ( sweeps ) * P * M / elapsed.count()
+                  << " swap deltas/s  (checksum " << checksum << ")"
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
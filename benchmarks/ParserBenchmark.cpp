@@ -0,0 +1,96 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/config.h"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Parsing throughput (MB/s) of FileParser::parseVector (stream based)
+ * against FileParser::parseVectorMapped on the data_a1 instances.
+ *
+ * Usage: ParserBenchmark [repetitions]
+ */
+
+typedef void (*ParseFunction) ( const char*, std::vector<int>& );
+
+double
+throughput ( ParseFunction parse, const std::string& file, int repetitions )
+{
+    std::vector<int> values;
+
+    parse ( file.c_str(), values );
+
+    size_t bytes = ROADEF12COMMON::MappedFile ( file.c_str() ).size();
+
+    std::chrono::steady_clock::time_point start
+        = std::chrono::steady_clock::now();
+
+    for ( int i = 0 ; i < repetitions ; ++i )
+    {
+        values.clear();
+        parse ( file.c_str(), values );
+    }
+
+    std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+
+    return ( bytes * double ( repetitions ) ) / ( 1024.0 * 1024.0 ) /
+           elapsed.count();
+}
+
+int main ( int argc, char** argv )
+{
+    int repetitions = ( argc > 1 ) ? atoi ( argv[1] ) : 200;
+
+    std::cout << std::setw ( 20 ) << "file"
+              << std::setw ( 14 ) << "stream MB/s"
+              << std::setw ( 14 ) << "mapped MB/s" << std::endl;
+
+    for ( int i = 1 ; i <= 5 ; ++i )
+    {
+        std::string name = "model_a1_" + std::to_string ( i ) + ".txt";
+        std::string file = std::string ( PROJECT_SOURCE_DIR ) +
+                           "/roadef12-material/data/data_a1/" + name;
+
+        std::cout << std::setw ( 20 ) << name << std::fixed
+                  << std::setprecision ( 1 )
+                  << std::setw ( 14 )
+                  << throughput ( &ROADEF12COMMON::FileParser::parseVector,
+                                  file, repetitions )
+                  << std::setw ( 14 )
+                  << throughput ( &ROADEF12COMMON::FileParser::parseVectorMapped,
+                                  file, repetitions )
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
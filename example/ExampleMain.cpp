@@ -46,6 +46,10 @@ class ExampleService : public ROADEF12COMMON::Service
                       << " machines=" << params.machines.size()
                       << " resources=" << params.resources.size()
                       << std::endl;
+            std::cout << "endcandidates=" << candidates.getBuildTime() << "ms"
+                      << std::endl;
+            std::cout << "Number of candidates=" << candidates.size()
+                      << std::endl;
 
             if ( options.nullCopy )
             {
@@ -57,10 +61,9 @@ class ExampleService : public ROADEF12COMMON::Service
             }
             else
             {
-                std::cout << "Your code goes here" << std::endl;
-
-                // Don't forget to write a solution
-                firstAssignment.write ( options.solution.c_str() );
+                // Don't forget to write a solution. search() runs the
+                // built-in search selected by --search.
+                search ().write ( options.solution.c_str() );
             }
         }
 };
@@ -0,0 +1,434 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_COMPILED_INSTANCE_HPP
+#define __roadef12_COMPILED_INSTANCE_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/service/ServiceExceptions.hpp"
+#include "roadef12-common/util/MappedFile.hpp"
+#include "roadef12-common/util/ValuesView.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdint.h>
+#include <unistd.h>
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Header of a compiled instance. The file is the header followed by
+     * the raw integers of the model (native endianness), i.e. the very
+     * same layout Parameters works on.
+     *
+     * @author daniperez
+     */
+    struct CompiledInstanceHeader
+    {
+        /**
+         * Always CompiledInstance::MAGIC.
+         */
+        uint32_t magic;
+
+        /**
+         * Format version (CompiledInstance::VERSION).
+         */
+        uint32_t version;
+
+        /**
+         * Hash of the text model the instance was compiled from.
+         */
+        uint64_t contentHash;
+
+        /**
+         * Number of integers in the payload.
+         */
+        uint64_t numValues;
+    };
+
+    /**
+     * Model loader with a binary cache. The text model is hashed and,
+     * if "<model>.bin" was compiled from the same content, the integers
+     * are used straight from the mapped cache file (no copy, no
+     * tokenization). Otherwise the text is tokenized, the machine move
+     * costs going straight into a MoveCostMatrix: the M x M integers are
+     * never held in memory, and values() come without them (see
+     * getMoveCosts).
+     *
+     * @author daniperez
+     */
+    class CompiledInstance : private boost::noncopyable
+    {
+        public:
+
+            /**
+             * "R12C" in little endian.
+             */
+            static const uint32_t MAGIC   = 0x43323152;
+
+            /**
+             * Current format version.
+             */
+            static const uint32_t VERSION = 2;
+
+            /**
+             * Constructor. Loads the given text model, from its cache
+             * if a matching one is present.
+             *
+             * @param modelFile Text model as per ROADEF's format.
+             * @param cacheFileName Compiled instance to look for. By
+             *        default, the one given by getCacheFileName.
+             * @throw IOException if the model cannot be read.
+             * @throw ParseException if the model has wrong format.
+             */
+            CompiledInstance
+            (
+                const char* modelFile,
+                const char* cacheFileName = NULL
+            )
+            throw ( ROADEF12COMMON::IOException, ROADEF12COMMON::ParseException )
+                : _view ( NULL, 0 )
+            {
+                MappedFile text ( modelFile );
+
+                uint64_t contentHash = hash ( text.data(), text.size() );
+
+                std::string cacheFile
+                    = ( cacheFileName != NULL ) ?
+                      std::string ( cacheFileName ) :
+                      getCacheFileName ( modelFile );
+
+                if ( ::access ( cacheFile.c_str(), R_OK ) == 0 )
+                {
+                    _cache.reset ( new MappedFile ( cacheFile.c_str() ) );
+
+                    if ( ! isValid ( *_cache, contentHash ) )
+                    {
+                        _cache.reset();
+                    }
+                }
+
+                if ( _cache )
+                {
+                    const CompiledInstanceHeader* header = getHeader ( *_cache );
+
+                    _view = ValuesView
+                    (
+                        reinterpret_cast<const int*> ( header + 1 ),
+                        header->numValues
+                    );
+                }
+                else
+                {
+                    _moveCosts = parseWithoutMoveCosts ( text.data(),
+                                                         text.data() + text.size(),
+                                                         _values, modelFile );
+
+                    _view = ValuesView ( _values );
+                }
+            }
+
+            /**
+             * The model's integers.
+             *
+             * @return View valid while this object lives.
+             */
+            const ValuesView&
+            values () const
+            {
+                return _view;
+            }
+
+            /**
+             * Machine move costs, if values() come without them, to be
+             * given to Parameters along with values().
+             *
+             * @return Matrix, or none if values() follow ROADEF's format
+             *         (model loaded from its cache).
+             */
+            const boost::shared_ptr<const MoveCostMatrix>&
+            getMoveCosts () const
+            {
+                return _moveCosts;
+            }
+
+            /**
+             * Says if the model was loaded from its cache.
+             *
+             * @return True if the cache was used.
+             */
+            bool
+            isCached () const
+            {
+                return _cache.get() != NULL;
+            }
+
+        public:
+
+            /**
+             * @name Compilation
+             */
+            ///@{
+            /**
+             * Compiles a text model into its binary form.
+             *
+             * @param modelFile Text model as per ROADEF's format.
+             * @param cacheFile File to write (see getCacheFileName).
+             * @throw IOException if the files cannot be read or written.
+             * @throw ParseException if the model has wrong format.
+             */
+            static void
+            compile ( const char* modelFile, const char* cacheFile )
+            throw ( ROADEF12COMMON::IOException, ROADEF12COMMON::ParseException )
+            {
+                MappedFile text ( modelFile );
+
+                std::vector<int> values;
+
+                FileParser::parseBuffer ( text.data(),
+                                          text.data() + text.size(),
+                                          values, modelFile );
+
+                CompiledInstanceHeader header;
+
+                header.magic       = MAGIC;
+                header.version     = VERSION;
+                header.contentHash = hash ( text.data(), text.size() );
+                header.numValues   = values.size();
+
+                std::ofstream output ( cacheFile,
+                                       std::ios::out | std::ios::binary );
+
+                output.write ( reinterpret_cast<const char*> ( &header ),
+                               sizeof ( header ) );
+                output.write ( reinterpret_cast<const char*> ( values.data() ),
+                               values.size() * sizeof ( int ) );
+                output.close();
+
+                if ( output.fail() )
+                {
+                    throw ROADEF12COMMON::IOException
+                    (
+                        (std::string(cacheFile) +
+                            std::string (" cannot be written")).c_str()
+                    );
+                }
+            }
+
+            /**
+             * Name of the cache file of a model.
+             *
+             * @param modelFile Text model.
+             * @return modelFile followed by ".bin".
+             */
+            static std::string
+            getCacheFileName ( const char* modelFile )
+            {
+                return std::string ( modelFile ) + ".bin";
+            }
+
+            /**
+             * 64-bit FNV-1a hash of a text.
+             *
+             * @param data First byte.
+             * @param size Number of bytes.
+             * @return Hash.
+             */
+            static uint64_t
+            hash ( const char* data, size_t size )
+            {
+                uint64_t result = 14695981039346656037ULL;
+
+                for ( size_t i = 0 ; i < size ; ++i )
+                {
+                    result ^= static_cast<unsigned char> ( data[i] );
+                    result *= 1099511628211ULL;
+                }
+
+                return result;
+            }
+            ///@}
+
+        protected:
+
+            /**
+             * Tokenizes a text model, encoding the machine move costs
+             * as they come instead of storing them.
+             *
+             * @param begin First character.
+             * @param end Past-the-end character.
+             * @param values Output, the model without the move costs.
+             * @param name Name of the model, for error reporting.
+             * @return Move costs.
+             * @throw ParseException if the model has wrong format.
+             */
+            static boost::shared_ptr<const MoveCostMatrix>
+            parseWithoutMoveCosts ( const char* begin,
+                                    const char* end,
+                                    std::vector<int>& values,
+                                    const char* name )
+            throw ( ROADEF12COMMON::ParseException )
+            {
+                const char* it    = begin;
+                const size_t size = FileParser::countTokens ( begin, end );
+
+                // Resources: count and 2 integers each
+                const int numResources = next ( it, end, name );
+
+                values.push_back ( numResources );
+
+                for ( int i = 0 ; i < 2*numResources ; ++i )
+                {
+                    values.push_back ( next ( it, end, name ) );
+                }
+
+                // Machines: count, then neighborhood, location, capacities,
+                // safety capacities and move costs each
+                const int numMachines = next ( it, end, name );
+
+                if ( numResources < 0 || numMachines < 0 ||
+                     size < uint64_t ( numMachines ) * numMachines )
+                {
+                    throw ROADEF12COMMON::ParseException
+                    (
+                        (std::string(name) +
+                            std::string (" has a wrong machine section")).c_str()
+                    );
+                }
+
+                values.reserve ( size - uint64_t ( numMachines ) * numMachines );
+                values.push_back ( numMachines );
+
+                boost::shared_ptr<MoveCostMatrix> moveCosts
+                    ( new MoveCostMatrix ( numMachines ) );
+
+                std::vector<int> row ( numMachines );
+
+                for ( int m = 0 ; m < numMachines ; ++m )
+                {
+                    for ( int i = 0 ; i < 2 + 2*numResources ; ++i )
+                    {
+                        values.push_back ( next ( it, end, name ) );
+                    }
+
+                    for ( int n = 0 ; n < numMachines ; ++n )
+                    {
+                        row [ n ] = next ( it, end, name );
+                    }
+
+                    moveCosts->setRow ( m, row.empty() ? NULL : &row[0] );
+                }
+
+                // The rest as is
+                int value;
+
+                while ( FileParser::readToken ( it, end, value, name ) )
+                {
+                    values.push_back ( value );
+                }
+
+                return moveCosts;
+            }
+
+            /**
+             * Next integer of a model that can't end there.
+             *
+             * @throw ParseException if the model ends.
+             */
+            static int
+            next ( const char*& it, const char* end, const char* name )
+            throw ( ROADEF12COMMON::ParseException )
+            {
+                int value;
+
+                if ( ! FileParser::readToken ( it, end, value, name ) )
+                {
+                    throw ROADEF12COMMON::ParseException
+                    (
+                        (std::string(name) +
+                            std::string (" is truncated")).c_str()
+                    );
+                }
+
+                return value;
+            }
+
+            /**
+             * Header of a mapped compiled instance.
+             *
+             * @param file Mapped compiled instance.
+             * @return Header.
+             */
+            static const CompiledInstanceHeader*
+            getHeader ( const MappedFile& file )
+            {
+                return reinterpret_cast<const CompiledInstanceHeader*>
+                       ( file.data() );
+            }
+
+            /**
+             * Says if a mapped file is a compiled instance of the
+             * given content.
+             *
+             * @param file Mapped file.
+             * @param contentHash Hash of the text model.
+             * @return True if the file can be used.
+             */
+            static bool
+            isValid ( const MappedFile& file, uint64_t contentHash )
+            {
+                bool valid = false;
+
+                if ( file.size() >= sizeof ( CompiledInstanceHeader ) )
+                {
+                    const CompiledInstanceHeader* header = getHeader ( file );
+
+                    valid = header->magic == MAGIC &&
+                            header->version == VERSION &&
+                            header->contentHash == contentHash &&
+                            file.size() == sizeof ( CompiledInstanceHeader ) +
+                                           header->numValues * sizeof ( int );
+                }
+
+                return valid;
+            }
+
+        private:
+
+            boost::shared_ptr<MappedFile>           _cache;
+            std::vector<int>                        _values;
+            ValuesView                              _view;
+            /** Move costs left out of _values, if parsed from the text. */
+            boost::shared_ptr<const MoveCostMatrix> _moveCosts;
+    };
+};
+
+#endif
@@ -26,13 +26,19 @@
 // roadef12
 #include "roadef12-common/util/Util.hpp"
 #include "roadef12-common/service/ServiceExceptions.hpp"
-#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/util/MappedFile.hpp"
 ///////////////////////////////////////////////////////////////////////////
 // STD
 #include <stdexcept>
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <vector>
+#include <limits>
+#include <stdint.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 ///////////////////////////////////////////////////////////////////////////
 // BOOST
 #include <boost/shared_ptr.hpp>
@@ -104,6 +110,231 @@ namespace ROADEF12COMMON {
                     );
                 }
             }
+
+            /**
+             * Same as parseVector but the file is memory-mapped and
+             * tokenized in place: a first pass counts the integers so
+             * that the output is resized once, a second pass converts
+             * the digits straight into the output buffer. No stream
+             * and no reallocation is involved.
+             *
+             * @param fileName File to parse.
+             * @param output vector to fill in (values are appended).
+             * @throw IOException if the input files cannot be read.
+             * @throw ParseException if the input files have wrong format.
+             */
+            static void
+            parseVectorMapped ( const char* fileName, std::vector<int>& output )
+            throw ( ROADEF12COMMON::IOException, ROADEF12COMMON::ParseException )
+            {
+                MappedFile file ( fileName );
+
+                parseBuffer ( file.data(), file.data() + file.size(),
+                              output, fileName );
+            }
+
+            /**
+             * Tokenizes the integers of an in-memory text (e.g. an already
+             * mapped file) as parseVectorMapped does.
+             *
+             * @param begin First character.
+             * @param end Past-the-end character.
+             * @param output vector to fill in (values are appended).
+             * @param name Name of the text, for error reporting.
+             * @throw ParseException if the text has wrong format.
+             */
+            static void
+            parseBuffer
+            (
+                const char* begin,
+                const char* end,
+                std::vector<int>& output,
+                const char* name
+            )
+            throw ( ROADEF12COMMON::ParseException )
+            {
+                size_t first = output.size();
+
+                output.resize ( first + countTokens ( begin, end ) );
+
+                if ( output.size() > first )
+                {
+                    tokenize ( begin, end, &output[first], name );
+                }
+            }
+
+        public:
+
+            /**
+             * Counts the integers (i.e. separator to non-separator
+             * transitions) in [begin,end). Uses SSE2 when available.
+             *
+             * @param begin First character.
+             * @param end Past-the-end character.
+             * @return Number of tokens.
+             */
+            static size_t
+            countTokens ( const char* begin, const char* end )
+            {
+                size_t count = 0;
+                bool previousIsSeparator = true;
+                const char* it = begin;
+
+                #ifdef __SSE2__
+                const __m128i space = _mm_set1_epi8 ( ' ' );
+                const __m128i flip  = _mm_set1_epi8 ( -128 );
+                const __m128i limit = _mm_xor_si128 ( space, flip );
+
+                for ( ; it + 16 <= end ; it += 16 )
+                {
+                    __m128i chunk = _mm_loadu_si128
+                        ( reinterpret_cast<const __m128i*> ( it ) );
+
+                    // Unsigned "c > ' '" by means of a signed compare.
+                    unsigned int tokens = _mm_movemask_epi8
+                    (
+                        _mm_cmpgt_epi8 ( _mm_xor_si128 ( chunk, flip ), limit )
+                    );
+
+                    unsigned int previous
+                        = ( tokens << 1 ) | ( previousIsSeparator ? 0 : 1 );
+
+                    count += __builtin_popcount ( tokens & ~previous & 0xFFFF );
+
+                    previousIsSeparator = ( ( tokens & 0x8000 ) == 0 );
+                }
+                #endif
+
+                for ( ; it < end ; ++it )
+                {
+                    bool separator = isSeparator ( *it );
+
+                    count += ( previousIsSeparator && ! separator ) ? 1 : 0;
+
+                    previousIsSeparator = separator;
+                }
+
+                return count;
+            }
+
+            /**
+             * Converts the next integer of [it,end), for the parsers that
+             * dispatch the integers as they come.
+             *
+             * @param it Current character, moved past the integer.
+             * @param end Past-the-end character.
+             * @param value Output, the integer.
+             * @param fileName File name, for error reporting.
+             * @return False if there are no more integers.
+             * @throw ParseException if the token is not an integer or
+             *        doesn't fit in an int.
+             */
+            static bool
+            readToken
+            (
+                const char*& it,
+                const char* end,
+                int& value,
+                const char* fileName
+            )
+            throw ( ROADEF12COMMON::ParseException )
+            {
+                while ( it < end && isSeparator ( *it ) )
+                {
+                    ++it;
+                }
+
+                if ( it == end )
+                {
+                    return false;
+                }
+
+                bool negative = ( *it == '-' );
+
+                if ( negative )
+                {
+                    ++it;
+                }
+
+                const char* digits = it;
+
+                // Magnitude of the most negative int included
+                const int64_t limit = int64_t ( std::numeric_limits<int>::max() ) +
+                                      ( negative ? 1 : 0 );
+                int64_t magnitude = 0;
+
+                while ( it < end && *it >= '0' && *it <= '9' )
+                {
+                    magnitude = magnitude*10 + ( *it - '0' );
+                    ++it;
+
+                    if ( magnitude > limit )
+                    {
+                        throw ROADEF12COMMON::ParseException
+                        (
+                            (std::string(fileName) +
+                                std::string (" contains an out-of-range integer")).c_str()
+                        );
+                    }
+                }
+
+                if ( it == digits || ( it < end && ! isSeparator ( *it ) ) )
+                {
+                    throw ROADEF12COMMON::ParseException
+                    (
+                        (std::string(fileName) +
+                            std::string (" contains a non-integer token")).c_str()
+                    );
+                }
+
+                value = int ( negative ? -magnitude : magnitude );
+
+                return true;
+            }
+
+        protected:
+
+            /**
+             * Says if the given character separates two integers. Any
+             * control character is taken as a separator.
+             *
+             * @param c Character.
+             * @return True if c is a separator.
+             */
+            static bool
+            isSeparator ( char c )
+            {
+                return static_cast<unsigned char> ( c ) <= ' ';
+            }
+
+            /**
+             * Converts the integers in [begin,end) and writes them to
+             * output, which must have room for all of them (see
+             * countTokens).
+             *
+             * @param begin First character.
+             * @param end Past-the-end character.
+             * @param output Where to write the integers to.
+             * @param fileName File name, for error reporting.
+             * @throw ParseException if a token is not an integer.
+             */
+            static void
+            tokenize
+            (
+                const char* begin,
+                const char* end,
+                int* output,
+                const char* fileName
+            )
+            throw ( ROADEF12COMMON::ParseException )
+            {
+                const char* it = begin;
+
+                while ( readToken ( it, end, *output, fileName ) )
+                {
+                    ++output;
+                }
+            }
     };
 };
 
@@ -0,0 +1,481 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_BATCH_EVALUATOR_HPP
+#define __roadef12_BATCH_EVALUATOR_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/util/AlignedAllocator.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <algorithm>
+#include <limits>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Shift deltas (see Evaluator::deltaShift) for a whole batch of
+     * candidates at once: one process to every machine, or many processes
+     * to one machine. The data of the candidates is laid out resource-major
+     * in aligned scratch arrays, so the load and balance terms are computed
+     * by branch-free, unit-stride loops over the candidates that the
+     * compiler vectorizes. Models whose balance terms may not fit in an
+     * int fall back to a scalar 64-bit balance loop.
+     *
+     * @author daniperez
+     */
+    class BatchEvaluator : public Evaluator
+    {
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the evaluator.
+             */
+            BatchEvaluator ( const Parameters& parameters )
+                : Evaluator ( parameters ),
+                  _machineStride ( pad ( _model.getNumMachines() ) ),
+                  _narrowBalances ( hasNarrowBalances() ),
+                  _moveCosts ( _model.getNumMachines() )
+            {
+                const uint numResources = _model.getNumResources();
+
+                _safetyByResource.assign ( numResources*_machineStride, 0 );
+                _capacityByResource.assign ( numResources*_machineStride, 0 );
+
+                for ( uint m = 0 ; m < _model.getNumMachines() ; ++m )
+                {
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        _safetyByResource [ r*_machineStride + m ]
+                            = _model.getSafetyCapacities ( m ) [ r ];
+                        _capacityByResource [ r*_machineStride + m ]
+                            = _model.getCapacities ( m ) [ r ];
+                    }
+                }
+            }
+
+        public:
+
+            /**
+             * Deltas of moving the process to each machine. O(M*(R+B)).
+             *
+             * @param assignment Current assignment.
+             * @param process Process to move.
+             * @param deltas Output, M deltas indexed by machine (0 for the
+             *        current machine of the process).
+             */
+            void
+            evaluateMachines ( const Assignment& assignment,
+                               uint process,
+                               int64_t* deltas )
+            {
+                const uint  numMachines  = _model.getNumMachines();
+                const uint  numResources = _model.getNumResources();
+                const uint  from         = assignment.getMachine ( process );
+                const uint  original     = assignment.getOriginalMachine ( process );
+                const int*  requirements = _model.getRequirements ( process );
+
+                // Destinations: loads gathered resource-major, the
+                // requirements of the process broadcast
+                reserve ( numResources*_machineStride );
+
+                for ( uint m = 0 ; m < numMachines ; ++m )
+                {
+                    const uint* load = assignment.getUtilizations ( m );
+
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        _load [ r*_machineStride + m ] = load [ r ];
+                    }
+                }
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    std::fill ( &_change [ r*_machineStride ],
+                                &_change [ r*_machineStride ] + numMachines,
+                                requirements [ r ] );
+                }
+
+                // Terms common to all the destinations
+                const int64_t leave
+                    = getMachineDelta ( from, assignment.getUtilizations ( from ),
+                                        &_zeros[0], requirements );
+                const int     moved = ( from == original ) ? 1 : 0;
+
+                _parameters.machines.getMovingCosts ( original, &_moveCosts[0] );
+
+                const int64_t common
+                    = leave +
+                      int64_t ( moved ) * _model.getPMC ( process ) *
+                          _model.getProcessMoveCostWeight() -
+                      int64_t ( _moveCosts [ from ] ) *
+                          _model.getMachineMoveCostWeight() +
+                      getServiceMoveDelta ( assignment,
+                                            _model.getService ( process ), moved,
+                                            0, 0 );
+
+                const int64_t mmcWeight = _model.getMachineMoveCostWeight();
+
+                for ( uint m = 0 ; m < numMachines ; ++m )
+                {
+                    deltas [ m ] = common + mmcWeight * _moveCosts [ m ];
+                }
+
+                addMachineDeltas ( numMachines, _machineStride,
+                                   &_load[0],
+                                   &_safetyByResource[0],
+                                   &_capacityByResource[0],
+                                   &_change[0],
+                                   deltas );
+
+                // Coming back home: the process stops counting as moved
+                if ( from != original )
+                {
+                    deltas [ original ]
+                        += getMoveCostDelta ( assignment, process, from, original, -1 ) -
+                           getMoveCostDelta ( assignment, process, from, original, 0 ) +
+                           getServiceMoveDelta ( assignment,
+                                                 _model.getService ( process ), -1,
+                                                 0, 0 );
+                }
+
+                deltas [ from ] = 0;
+            }
+
+            /**
+             * Deltas of moving each of the given processes to the machine.
+             * O(n*(R+B)).
+             *
+             * @param assignment Current assignment.
+             * @param machine Destination machine.
+             * @param processes Candidate processes.
+             * @param deltas Output, one delta per candidate (0 for the
+             *        ones already on the machine).
+             */
+            void
+            evaluateProcesses ( const Assignment& assignment,
+                                uint machine,
+                                const ProcessRange& processes,
+                                int64_t* deltas )
+            {
+                const uint  n            = processes.size();
+                const uint  numResources = _model.getNumResources();
+                const uint  stride       = pad ( n );
+                const uint* target       = assignment.getUtilizations ( machine );
+                const int*  safety       = _model.getSafetyCapacities ( machine );
+                const int*  capacity     = _model.getCapacities ( machine );
+
+                reserve ( numResources*stride );
+
+                // Arrival: the destination broadcast, requirements gathered
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    int* load  = &_load [ r*stride ];
+                    int* safe  = &_safety [ r*stride ];
+                    int* cap   = &_capacity [ r*stride ];
+                    int* in    = &_change [ r*stride ];
+                    int* out   = &_change [ ( numResources + r )*stride ];
+
+                    for ( uint i = 0 ; i < n ; ++i )
+                    {
+                        load [ i ] = target [ r ];
+                        safe [ i ] = safety [ r ];
+                        cap [ i ]  = capacity [ r ];
+                        in [ i ]   = _model.getRequirements ( processes [ i ] ) [ r ];
+                        out [ i ]  = -in [ i ];
+                    }
+                }
+
+                for ( uint i = 0 ; i < n ; ++i )
+                {
+                    const uint process = processes [ i ];
+                    const uint from    = assignment.getMachine ( process );
+                    const int  moved   = getMovedDelta ( assignment, process,
+                                                         from, machine );
+
+                    deltas [ i ]
+                        = getMoveCostDelta ( assignment, process, from, machine, moved ) +
+                          getServiceMoveDelta ( assignment,
+                                                _model.getService ( process ), moved,
+                                                0, 0 );
+                }
+
+                addMachineDeltas ( n, stride, &_load[0], &_safety[0],
+                                   &_capacity[0], &_change[0], deltas );
+
+                // Departure: the source machines gathered
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    int* load  = &_load [ r*stride ];
+                    int* safe  = &_safety [ r*stride ];
+                    int* cap   = &_capacity [ r*stride ];
+
+                    for ( uint i = 0 ; i < n ; ++i )
+                    {
+                        const uint from = assignment.getMachine ( processes [ i ] );
+
+                        load [ i ] = assignment.getUtilizations ( from ) [ r ];
+                        safe [ i ] = _model.getSafetyCapacities ( from ) [ r ];
+                        cap [ i ]  = _model.getCapacities ( from ) [ r ];
+                    }
+                }
+
+                addMachineDeltas ( n, stride, &_load[0], &_safety[0],
+                                   &_capacity[0],
+                                   &_change [ numResources*stride ], deltas );
+
+                for ( uint i = 0 ; i < n ; ++i )
+                {
+                    if ( assignment.getMachine ( processes [ i ] ) == machine )
+                    {
+                        deltas [ i ] = 0;
+                    }
+                }
+            }
+
+        protected:
+
+            /**
+             * Adds to each candidate's delta the change in load and balance
+             * cost of its machine. Arrays are resource-major: entry i of
+             * resource r is at [r*stride + i].
+             *
+             * @param n Number of candidates.
+             * @param stride Row length of the arrays.
+             * @param load Current loads.
+             * @param safety Safety capacities.
+             * @param capacity Capacities.
+             * @param change Signed change of the loads.
+             * @param deltas Deltas to add to.
+             */
+            void
+            addMachineDeltas ( uint n,
+                               uint stride,
+                               const int* load,
+                               const int* safety,
+                               const int* capacity,
+                               const int* change,
+                               int64_t* deltas )
+            {
+                int* term = &_term[0];
+
+                for ( uint r = 0 ; r < _model.getNumResources() ; ++r )
+                {
+                    const int* l = load + r*stride;
+                    const int* s = safety + r*stride;
+                    const int* c = change + r*stride;
+                    const int  w = _model.getLoadCostWeights() [ r ];
+
+                    for ( uint i = 0 ; i < n ; ++i )
+                    {
+                        const int before = l [ i ] - s [ i ];
+                        const int after  = before + c [ i ];
+
+                        term [ i ] = std::max ( after, 0 ) - std::max ( before, 0 );
+                    }
+
+                    accumulate ( n, w, term, deltas );
+                }
+
+                for ( uint b = 0 ; b < _model.getNumBalances() ; ++b )
+                {
+                    const uint r1     = _model.getBalanceR1 ( b );
+                    const uint r2     = _model.getBalanceR2 ( b );
+                    const int  target = _model.getBalanceTarget ( b );
+
+                    const int* l1 = load + r1*stride;
+                    const int* l2 = load + r2*stride;
+                    const int* c1 = capacity + r1*stride;
+                    const int* c2 = capacity + r2*stride;
+                    const int* d1 = change + r1*stride;
+                    const int* d2 = change + r2*stride;
+
+                    if ( ! _narrowBalances )
+                    {
+                        addWideBalanceDeltas ( n, b, l1, l2, c1, c2, d1, d2, deltas );
+                        continue;
+                    }
+
+                    for ( uint i = 0 ; i < n ; ++i )
+                    {
+                        const int before = target * ( c1 [ i ] - l1 [ i ] ) -
+                                           ( c2 [ i ] - l2 [ i ] );
+                        const int after  = target * ( c1 [ i ] - l1 [ i ] - d1 [ i ] ) -
+                                           ( c2 [ i ] - l2 [ i ] - d2 [ i ] );
+
+                        term [ i ] = std::max ( after, 0 ) - std::max ( before, 0 );
+                    }
+
+                    accumulate ( n, _model.getBalanceWeight ( b ), term, deltas );
+                }
+            }
+
+            /**
+             * Same as the balance loop of addMachineDeltas, in 64-bit
+             * arithmetic and not vectorized, for models where target
+             * times capacity doesn't fit in an int.
+             */
+            void
+            addWideBalanceDeltas ( uint n,
+                                   uint balance,
+                                   const int* l1,
+                                   const int* l2,
+                                   const int* c1,
+                                   const int* c2,
+                                   const int* d1,
+                                   const int* d2,
+                                   int64_t* deltas ) const
+            {
+                const int64_t target = _model.getBalanceTarget ( balance );
+                const int64_t weight = _model.getBalanceWeight ( balance );
+
+                for ( uint i = 0 ; i < n ; ++i )
+                {
+                    const int64_t available1 = int64_t ( c1 [ i ] ) - l1 [ i ];
+                    const int64_t available2 = int64_t ( c2 [ i ] ) - l2 [ i ];
+                    const int64_t before     = target * available1 - available2;
+                    const int64_t after      = before - target * d1 [ i ] + d2 [ i ];
+
+                    deltas [ i ] += weight * ( std::max ( after, int64_t ( 0 ) ) -
+                                               std::max ( before, int64_t ( 0 ) ) );
+                }
+            }
+
+            /**
+             * deltas[i] += weight*term[i].
+             */
+            static void
+            accumulate ( uint n, int weight, const int* term, int64_t* deltas )
+            {
+                const int64_t w = weight;
+
+                for ( uint i = 0 ; i < n ; ++i )
+                {
+                    deltas [ i ] += w * term [ i ];
+                }
+            }
+
+            /**
+             * Says if the balance terms of any candidate fit in an int.
+             * Loads and loads after a shift stay in [0, total requirement],
+             * so |capacity - load| <= max(capacity, total requirement) =
+             * B(r), and every term is bounded by target*B(r1) + B(r2).
+             */
+            bool
+            hasNarrowBalances () const
+            {
+                const uint numResources = _model.getNumResources();
+
+                std::vector<int64_t> bound ( numResources, 0 );
+
+                for ( uint p = 0 ; p < _model.getNumProcesses() ; ++p )
+                {
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        bound [ r ] += _model.getRequirements ( p ) [ r ];
+                    }
+                }
+
+                for ( uint m = 0 ; m < _model.getNumMachines() ; ++m )
+                {
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        bound [ r ] = std::max<int64_t> ( bound [ r ],
+                                                          _model.getCapacities ( m ) [ r ] );
+                    }
+                }
+
+                for ( uint b = 0 ; b < _model.getNumBalances() ; ++b )
+                {
+                    const int64_t target = _model.getBalanceTarget ( b );
+
+                    if ( target < 0 ||
+                         std::max<int64_t> ( target, 1 ) * bound [ _model.getBalanceR1 ( b ) ] +
+                         bound [ _model.getBalanceR2 ( b ) ] >
+                         std::numeric_limits<int>::max() )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Grows the scratch arrays to hold size integers (per array).
+             *
+             * @param size Number of integers.
+             */
+            void
+            reserve ( uint size )
+            {
+                if ( _load.size() < size )
+                {
+                    _load.resize ( size );
+                    _safety.resize ( size );
+                    _capacity.resize ( size );
+                    _change.resize ( 2*size );
+                    _term.resize ( size );
+                }
+            }
+
+            /**
+             * Rounds n up to a whole number of cache lines of integers.
+             *
+             * @param n Number of integers.
+             * @return Padded size.
+             */
+            static uint
+            pad ( uint n )
+            {
+                const uint perLine = 64 / sizeof ( int );
+
+                return std::max ( perLine, ( n + perLine - 1 ) / perLine * perLine );
+            }
+
+        private:
+
+            /** Row length of the per-machine arrays. */
+            const uint        _machineStride;
+            /** True if the balance terms fit in int lanes (see hasNarrowBalances). */
+            const bool        _narrowBalances;
+            /** Safety capacities, [R][_machineStride]. */
+            AlignedIntVector  _safetyByResource;
+            /** Capacities, [R][_machineStride]. */
+            AlignedIntVector  _capacityByResource;
+            /** Scratch: decoded move costs from the original machine. */
+            std::vector<int>  _moveCosts;
+            /** Scratch, resource-major. */
+            AlignedIntVector  _load;
+            AlignedIntVector  _safety;
+            AlignedIntVector  _capacity;
+            AlignedIntVector  _change;
+            AlignedIntVector  _term;
+    };
+};
+
+#endif
@@ -0,0 +1,476 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_EVALUATOR_HPP
+#define __roadef12_EVALUATOR_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Objective function value, split by term. Every term is already
+     * weighted, so total() is what the ROADEF checker reports.
+     *
+     * @author daniperez
+     */
+    struct Cost
+    {
+        int64_t load;
+        int64_t balance;
+        int64_t processMove;
+        int64_t serviceMove;
+        int64_t machineMove;
+
+        /**
+         * @return Sum of all the terms.
+         */
+        int64_t
+        total () const
+        {
+            return load + balance + processMove + serviceMove + machineMove;
+        }
+    };
+
+    /**
+     * Computes the objective function of an assignment directly from the
+     * parameters (see CompiledModel) and the loads cached by Assignment,
+     * without going through the ROADEF checker. A full evaluation is
+     * O(M*(R+B) + P).
+     *
+     * @author daniperez
+     */
+    class Evaluator
+    {
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the evaluator.
+             */
+            Evaluator ( const Parameters& parameters )
+                : _parameters ( parameters ),
+                  _model ( parameters.compiled ),
+                  _movedPerService ( _model.getNumServices(), 0 ),
+                  _zeros ( _model.getResourceStride(), 0 )
+            {
+            }
+
+            /**
+             * Evaluates an assignment with respect to its own original
+             * assignment (see Assignment::getOriginalMachine).
+             *
+             * @param current Assignment to evaluate.
+             * @return Cost.
+             */
+            Cost
+            evaluate ( const Assignment& current )
+            {
+                return evaluate ( current, current );
+            }
+
+            /**
+             * Evaluates an assignment with respect to an initial one.
+             *
+             * @param initial Initial assignment, moves are counted from it.
+             * @param current Assignment to evaluate.
+             * @return Cost.
+             */
+            Cost
+            evaluate ( const Assignment& initial, const Assignment& current )
+            {
+                Cost cost = { 0, 0, 0, 0, 0 };
+
+                for ( uint m = 0 ; m < _model.getNumMachines() ; ++m )
+                {
+                    const uint* load = current.getUtilizations ( m );
+
+                    cost.load    += getLoadCost ( m, load );
+                    cost.balance += getBalanceCost ( m, load );
+                }
+
+                int64_t pmc = 0;
+                int64_t mmc = 0;
+
+                std::fill ( _movedPerService.begin(), _movedPerService.end(), 0 );
+
+                for ( uint p = 0 ; p < _model.getNumProcesses() ; ++p )
+                {
+                    const uint from = initialMachine ( initial, current, p );
+                    const uint to   = current.getMachine ( p );
+
+                    mmc += _parameters.machines.getMovingCost ( from, to );
+
+                    if ( from != to )
+                    {
+                        pmc += _model.getPMC ( p );
+                        ++_movedPerService [ _model.getService ( p ) ];
+                    }
+                }
+
+                cost.processMove = pmc * _model.getProcessMoveCostWeight();
+                cost.machineMove = mmc * _model.getMachineMoveCostWeight();
+                int maxMoved = 0;
+
+                for ( uint s = 0 ; s < _movedPerService.size() ; ++s )
+                {
+                    maxMoved = std::max ( maxMoved, _movedPerService [ s ] );
+                }
+
+                cost.serviceMove
+                    = int64_t ( _model.getServiceMoveCostWeight() ) * maxMoved;
+
+                return cost;
+            }
+
+        public:
+
+            /**
+             * @name Delta evaluation.
+             *
+             * Exact change in total() if a move were applied to the
+             * assignment, with moves counted from the assignment's
+             * original machines. The assignment is not modified.
+             */
+            ///@{
+            /**
+             * Change of objective of moving process to machine. Only the
+             * two machines involved are looked at: O(R+B).
+             *
+             * @param assignment Current assignment.
+             * @param process Process to move.
+             * @param machine Destination machine.
+             * @return New cost minus current cost.
+             */
+            int64_t
+            deltaShift ( const Assignment& assignment,
+                         uint process,
+                         uint machine ) const
+            {
+                const uint from = assignment.getMachine ( process );
+
+                if ( from == machine )
+                {
+                    return 0;
+                }
+
+                const int* requirements = _model.getRequirements ( process );
+
+                int64_t delta
+                    = getMachineDelta ( from,
+                                        assignment.getUtilizations ( from ),
+                                        &_zeros[0], requirements ) +
+                      getMachineDelta ( machine,
+                                        assignment.getUtilizations ( machine ),
+                                        requirements, &_zeros[0] );
+
+                const int moved = getMovedDelta ( assignment, process, from, machine );
+
+                delta += getMoveCostDelta ( assignment, process, from, machine, moved );
+
+                delta += getServiceMoveDelta ( assignment,
+                                               _model.getService ( process ), moved,
+                                               0, 0 );
+
+                return delta;
+            }
+
+            /**
+             * Change of objective of exchanging the machines of two
+             * processes, as done by Assignment::swap. O(R+B).
+             *
+             * @param assignment Current assignment.
+             * @param process1 First process.
+             * @param process2 Second process.
+             * @return New cost minus current cost.
+             */
+            int64_t
+            deltaSwap ( const Assignment& assignment,
+                        uint process1,
+                        uint process2 ) const
+            {
+                const uint machine1 = assignment.getMachine ( process1 );
+                const uint machine2 = assignment.getMachine ( process2 );
+
+                if ( machine1 == machine2 )
+                {
+                    return 0;
+                }
+
+                const int* requirements1 = _model.getRequirements ( process1 );
+                const int* requirements2 = _model.getRequirements ( process2 );
+
+                // Each machine's balance terms see both changes at once
+                int64_t delta
+                    = getMachineDelta ( machine1,
+                                        assignment.getUtilizations ( machine1 ),
+                                        requirements2, requirements1 ) +
+                      getMachineDelta ( machine2,
+                                        assignment.getUtilizations ( machine2 ),
+                                        requirements1, requirements2 );
+
+                const int moved1
+                    = getMovedDelta ( assignment, process1, machine1, machine2 );
+                const int moved2
+                    = getMovedDelta ( assignment, process2, machine2, machine1 );
+
+                delta += getMoveCostDelta ( assignment, process1,
+                                            machine1, machine2, moved1 );
+                delta += getMoveCostDelta ( assignment, process2,
+                                            machine2, machine1, moved2 );
+
+                delta += getServiceMoveDelta ( assignment,
+                                               _model.getService ( process1 ), moved1,
+                                               _model.getService ( process2 ), moved2 );
+
+                return delta;
+            }
+            ///@}
+
+        public:
+
+            /**
+             * @name Cost of a single machine.
+             */
+            ///@{
+            /**
+             * Load cost of a machine given its utilization.
+             *
+             * @param machine Machine's id.
+             * @param load Row of R loads.
+             * @return Weighted load cost.
+             */
+            int64_t
+            getLoadCost ( uint machine, const uint* load ) const
+            {
+                const int* safety  = _model.getSafetyCapacities ( machine );
+                const int* weights = _model.getLoadCostWeights ();
+                int64_t    cost    = 0;
+
+                for ( uint r = 0 ; r < _model.getNumResources() ; ++r )
+                {
+                    cost += int64_t ( weights [ r ] ) *
+                            std::max ( int64_t ( load [ r ] ) - safety [ r ],
+                                       int64_t ( 0 ) );
+                }
+
+                return cost;
+            }
+
+            /**
+             * Balance cost of a machine given its utilization, for all
+             * the balance objectives.
+             *
+             * @param machine Machine's id.
+             * @param load Row of R loads.
+             * @return Weighted balance cost.
+             */
+            int64_t
+            getBalanceCost ( uint machine, const uint* load ) const
+            {
+                const int* capacities = _model.getCapacities ( machine );
+                int64_t    cost       = 0;
+
+                for ( uint b = 0 ; b < _model.getNumBalances() ; ++b )
+                {
+                    const uint r1 = _model.getBalanceR1 ( b );
+                    const uint r2 = _model.getBalanceR2 ( b );
+
+                    const int64_t available1 = int64_t ( capacities [ r1 ] ) - load [ r1 ];
+                    const int64_t available2 = int64_t ( capacities [ r2 ] ) - load [ r2 ];
+
+                    cost += int64_t ( _model.getBalanceWeight ( b ) ) *
+                            std::max ( _model.getBalanceTarget ( b ) * available1 -
+                                           available2,
+                                       int64_t ( 0 ) );
+                }
+
+                return cost;
+            }
+
+            /**
+             * Change of load plus balance cost of a machine when the
+             * requirements of one process come in and the ones of another
+             * leave.
+             *
+             * @param machine Machine's id.
+             * @param load Current row of R loads.
+             * @param in Row of R requirements added.
+             * @param out Row of R requirements removed.
+             * @return Weighted cost delta.
+             */
+            int64_t
+            getMachineDelta ( uint machine,
+                              const uint* load,
+                              const int* in,
+                              const int* out ) const
+            {
+                const int* safety     = _model.getSafetyCapacities ( machine );
+                const int* capacities = _model.getCapacities ( machine );
+                const int* weights    = _model.getLoadCostWeights ();
+                int64_t    delta      = 0;
+
+                for ( uint r = 0 ; r < _model.getNumResources() ; ++r )
+                {
+                    const int64_t before = int64_t ( load [ r ] ) - safety [ r ];
+                    const int64_t after  = before + in [ r ] - out [ r ];
+
+                    delta += int64_t ( weights [ r ] ) *
+                             ( std::max ( after, int64_t ( 0 ) ) -
+                               std::max ( before, int64_t ( 0 ) ) );
+                }
+
+                for ( uint b = 0 ; b < _model.getNumBalances() ; ++b )
+                {
+                    const uint    r1     = _model.getBalanceR1 ( b );
+                    const uint    r2     = _model.getBalanceR2 ( b );
+                    const int64_t target = _model.getBalanceTarget ( b );
+
+                    const int64_t available1 = int64_t ( capacities [ r1 ] ) - load [ r1 ];
+                    const int64_t available2 = int64_t ( capacities [ r2 ] ) - load [ r2 ];
+                    const int64_t before     = target * available1 - available2;
+                    const int64_t after      = before -
+                                               target * ( in [ r1 ] - out [ r1 ] ) +
+                                               ( in [ r2 ] - out [ r2 ] );
+
+                    delta += int64_t ( _model.getBalanceWeight ( b ) ) *
+                             ( std::max ( after, int64_t ( 0 ) ) -
+                               std::max ( before, int64_t ( 0 ) ) );
+                }
+
+                return delta;
+            }
+            ///@}
+
+        protected:
+
+            /**
+             * Initial machine of a process: the one of the initial
+             * assignment, or the original one if both are the same object.
+             */
+            static uint
+            initialMachine ( const Assignment& initial,
+                             const Assignment& current,
+                             uint process )
+            {
+                return ( &initial == &current )
+                       ? current.getOriginalMachine ( process )
+                       : initial.getMachine ( process );
+            }
+
+            /**
+             * Change in the number of moved processes when the process
+             * goes from one machine to another: 1 if it leaves its original
+             * machine, -1 if it comes back to it, 0 otherwise.
+             */
+            static int
+            getMovedDelta ( const Assignment& assignment,
+                            uint process,
+                            uint from,
+                            uint to )
+            {
+                const uint original = assignment.getOriginalMachine ( process );
+
+                return ( from == original ) ?  1 :
+                       ( to == original )   ? -1 : 0;
+            }
+
+            /**
+             * Change of the (weighted) process and machine move costs when
+             * the process goes from one machine to another.
+             *
+             * @param assignment Current assignment.
+             * @param process Process.
+             * @param from Current machine.
+             * @param to Destination machine.
+             * @param moved See getMovedDelta.
+             * @return Weighted cost delta.
+             */
+            int64_t
+            getMoveCostDelta ( const Assignment& assignment,
+                               uint process,
+                               uint from,
+                               uint to,
+                               int moved ) const
+            {
+                const uint original = assignment.getOriginalMachine ( process );
+
+                return int64_t ( moved ) * _model.getPMC ( process ) *
+                           _model.getProcessMoveCostWeight() +
+                       int64_t ( _parameters.machines.getMovingCost ( original, to ) -
+                                 _parameters.machines.getMovingCost ( original, from ) ) *
+                           _model.getMachineMoveCostWeight();
+            }
+
+            /**
+             * Change of the (weighted) service move cost if the number of
+             * moved processes of service1 changes by moved1 and the one
+             * of service2 by moved2 (both services may be the same). O(1),
+             * see ServiceMoveTracker.
+             *
+             * @param assignment Current assignment.
+             * @param service1 Service.
+             * @param moved1 Change in its number of moved processes.
+             * @param service2 Service.
+             * @param moved2 Change in its number of moved processes.
+             * @return Weighted cost delta.
+             */
+            int64_t
+            getServiceMoveDelta ( const Assignment& assignment,
+                                  uint service1, int moved1,
+                                  uint service2, int moved2 ) const
+            {
+                if ( moved1 == 0 && moved2 == 0 )
+                {
+                    return 0;
+                }
+
+                const ServiceMoveTracker& tracker
+                    = assignment.getServiceMoveTracker ();
+
+                return ( int64_t ( tracker.getMaxAfter ( service1, moved1,
+                                                         service2, moved2 ) ) -
+                         tracker.getMax () ) *
+                       _model.getServiceMoveCostWeight();
+            }
+
+        protected:
+
+            const Parameters&    _parameters;
+            const CompiledModel& _model;
+            /** Scratch counters of moved processes per service. */
+            std::vector<int>     _movedPerService;
+            /** Row of R zero requirements. */
+            const std::vector<int> _zeros;
+    };
+};
+
+#endif
@@ -0,0 +1,401 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_FEASIBILITY_ORACLE_HPP
+#define __roadef12_FEASIBILITY_ORACLE_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <boost/foreach.hpp>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Hard constraints of the problem: capacity, transient capacity,
+     * conflict, spread and dependency. canMove() tells if a single move
+     * keeps a feasible assignment feasible, looking only at the counters
+     * Assignment maintains; it doesn't allocate.
+     *
+     * @author daniperez
+     */
+    class FeasibilityOracle
+    {
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the oracle.
+             */
+            FeasibilityOracle ( const Parameters& parameters )
+                : _model ( parameters.compiled ),
+                  _services ( parameters.services )
+            {
+            }
+
+        public:
+
+            /**
+             * @name Single move.
+             */
+            ///@{
+            /**
+             * Says if moving the process to the machine satisfies all the
+             * constraints, given that the assignment does.
+             * O(R + processes of the service + dependencies).
+             *
+             * @param assignment Current, feasible, assignment.
+             * @param process Process to move.
+             * @param machine Destination machine.
+             * @return True if the move is legal.
+             */
+            bool
+            canMove ( const Assignment& assignment,
+                      uint process,
+                      uint machine ) const
+            {
+                const uint from = assignment.getMachine ( process );
+
+                return from == machine ||
+                       ( fitsCapacity ( assignment, process, machine ) &&
+                         hasNoConflict ( assignment, process, machine ) &&
+                         keepsSpread ( assignment, process, from, machine ) &&
+                         keepsDependencies ( assignment, process, from, machine ) );
+            }
+
+            /**
+             * Capacity and transient capacity of the destination. O(R).
+             */
+            bool
+            fitsCapacity ( const Assignment& assignment,
+                           uint process,
+                           uint machine ) const
+            {
+                const int*  requirements = _model.getRequirements ( process );
+                const int*  capacities   = _model.getCapacities ( machine );
+                const int*  transient    = _model.getTransientFlags ();
+                const uint* load         = assignment.getUtilizations ( machine );
+                const uint* kept         = assignment.getTransientUtilizations ( machine );
+
+                // Coming back home releases the transient usage it kept
+                const int   home
+                    = ( assignment.getOriginalMachine ( process ) == machine );
+
+                for ( uint r = 0 ; r < _model.getNumResources() ; ++r )
+                {
+                    const int64_t total
+                        = int64_t ( load [ r ] ) + requirements [ r ] +
+                          transient [ r ] *
+                            ( int64_t ( kept [ r ] ) - home*requirements [ r ] );
+
+                    if ( total > capacities [ r ] )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * No other process of the service on the destination.
+             * O(processes of the service).
+             */
+            bool
+            hasNoConflict ( const Assignment& assignment,
+                            uint process,
+                            uint machine ) const
+            {
+                BOOST_FOREACH ( ushort other,
+                                assignment.getProcessesPerService
+                                    ( _model.getService ( process ) ) )
+                {
+                    if ( other != process &&
+                         assignment.getMachine ( other ) == machine )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * The service keeps spreading over enough locations. O(1).
+             */
+            bool
+            keepsSpread ( const Assignment& assignment,
+                          uint process,
+                          uint from,
+                          uint to ) const
+            {
+                const uint service = _model.getService ( process );
+                const uint source  = _model.getLocation ( from );
+                const uint target  = _model.getLocation ( to );
+
+                if ( source == target )
+                {
+                    return true;
+                }
+
+                const int locations
+                    = assignment.getNumLocationsPerService ( service ) -
+                      ( assignment.getNumProcessesInLocation ( service, source ) == 1 ) +
+                      ( assignment.getNumProcessesInLocation ( service, target ) == 0 );
+
+                return locations >= _services.getMinSpread ( service );
+            }
+
+            /**
+             * The destination neighborhood has the services the process'
+             * service depends on, and leaving the source neighborhood
+             * doesn't strand processes of services depending on it.
+             * O(dependencies + dependents).
+             */
+            bool
+            keepsDependencies ( const Assignment& assignment,
+                                uint process,
+                                uint from,
+                                uint to ) const
+            {
+                const uint service = _model.getService ( process );
+                const uint source  = _model.getNeighborhood ( from );
+                const uint target  = _model.getNeighborhood ( to );
+
+                if ( source == target )
+                {
+                    return true;
+                }
+
+                const ValuesView dependencies = _services.getDependencies ( service );
+
+                for ( uint d = 0 ; d < dependencies.size() ; ++d )
+                {
+                    if ( assignment.getNumProcessesInNeighborhood
+                             ( dependencies [ d ], target ) == 0 )
+                    {
+                        return false;
+                    }
+                }
+
+                // Only vacating the neighborhood can strand a dependent
+                if ( assignment.getNumProcessesInNeighborhood ( service, source ) == 1 )
+                {
+                    const ValuesView dependents = _services.getDependents ( service );
+
+                    for ( uint d = 0 ; d < dependents.size() ; ++d )
+                    {
+                        if ( assignment.getNumProcessesInNeighborhood
+                                 ( dependents [ d ], source ) > 0 )
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            }
+            ///@}
+
+        public:
+
+            /**
+             * @name Swap.
+             */
+            ///@{
+            /**
+             * Says if an assignment that was feasible before the two
+             * processes exchanged their machines (see Assignment::swap)
+             * still is. Only what the swap touched is looked at: the two
+             * machines, the two services and the neighborhoods they left
+             * and entered. O(R + processes of both services + dependencies
+             * + dependents).
+             *
+             * @param swapped Assignment, after the swap.
+             * @param process1 First process.
+             * @param process2 Second process.
+             * @return True if the swap was legal.
+             */
+            bool
+            keepsFeasibleAfterSwap ( const Assignment& swapped,
+                                     uint process1,
+                                     uint process2 ) const
+            {
+                const uint machine1 = swapped.getMachine ( process2 );
+                const uint machine2 = swapped.getMachine ( process1 );
+
+                if ( machine1 == machine2 )
+                {
+                    return true;
+                }
+
+                const uint service1      = _model.getService ( process1 );
+                const uint service2      = _model.getService ( process2 );
+                const uint neighborhood1 = _model.getNeighborhood ( machine1 );
+                const uint neighborhood2 = _model.getNeighborhood ( machine2 );
+
+                return hasRoom ( swapped, machine1 ) &&
+                       hasRoom ( swapped, machine2 ) &&
+                       hasNoConflict ( swapped, process1, machine2 ) &&
+                       hasNoConflict ( swapped, process2, machine1 ) &&
+                       int ( swapped.getNumLocationsPerService ( service1 ) ) >=
+                           _services.getMinSpread ( service1 ) &&
+                       int ( swapped.getNumLocationsPerService ( service2 ) ) >=
+                           _services.getMinSpread ( service2 ) &&
+                       hasDependencies ( swapped, service1, neighborhood2 ) &&
+                       hasDependencies ( swapped, service2, neighborhood1 ) &&
+                       strandsNoDependent ( swapped, service1, neighborhood1 ) &&
+                       strandsNoDependent ( swapped, service2, neighborhood2 );
+            }
+
+            /**
+             * Load plus transient usage kept within capacity. O(R).
+             */
+            bool
+            hasRoom ( const Assignment& assignment, uint machine ) const
+            {
+                const int*  capacities = _model.getCapacities ( machine );
+                const int*  transient  = _model.getTransientFlags ();
+                const uint* load       = assignment.getUtilizations ( machine );
+                const uint* kept       = assignment.getTransientUtilizations ( machine );
+
+                for ( uint r = 0 ; r < _model.getNumResources() ; ++r )
+                {
+                    if ( int64_t ( load [ r ] ) + transient [ r ] * kept [ r ] >
+                         capacities [ r ] )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Every service the service depends on has a process in the
+             * neighborhood. O(dependencies).
+             */
+            bool
+            hasDependencies ( const Assignment& assignment,
+                              uint service,
+                              uint neighborhood ) const
+            {
+                const ValuesView dependencies = _services.getDependencies ( service );
+
+                for ( uint d = 0 ; d < dependencies.size() ; ++d )
+                {
+                    if ( assignment.getNumProcessesInNeighborhood
+                             ( dependencies [ d ], neighborhood ) == 0 )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * If the service has no process left in the neighborhood, no
+             * service depending on it has. O(dependents).
+             */
+            bool
+            strandsNoDependent ( const Assignment& assignment,
+                                 uint service,
+                                 uint neighborhood ) const
+            {
+                if ( assignment.getNumProcessesInNeighborhood ( service, neighborhood ) > 0 )
+                {
+                    return true;
+                }
+
+                const ValuesView dependents = _services.getDependents ( service );
+
+                for ( uint d = 0 ; d < dependents.size() ; ++d )
+                {
+                    if ( assignment.getNumProcessesInNeighborhood
+                             ( dependents [ d ], neighborhood ) > 0 )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+            ///@}
+
+        public:
+
+            /**
+             * Says if the whole assignment satisfies all the constraints.
+             * O(M*R + P*dependencies).
+             *
+             * @param assignment Assignment.
+             * @return True if feasible.
+             */
+            bool
+            isFeasible ( const Assignment& assignment ) const
+            {
+                for ( uint m = 0 ; m < _model.getNumMachines() ; ++m )
+                {
+                    if ( ! hasRoom ( assignment, m ) )
+                    {
+                        return false;
+                    }
+                }
+
+                for ( uint s = 0 ; s < _model.getNumServices() ; ++s )
+                {
+                    if ( int ( assignment.getNumLocationsPerService ( s ) ) <
+                         _services.getMinSpread ( s ) )
+                    {
+                        return false;
+                    }
+                }
+
+                for ( uint p = 0 ; p < _model.getNumProcesses() ; ++p )
+                {
+                    const uint machine = assignment.getMachine ( p );
+
+                    if ( ! hasNoConflict ( assignment, p, machine ) ||
+                         ! hasDependencies ( assignment, _model.getService ( p ),
+                                             _model.getNeighborhood ( machine ) ) )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+        private:
+
+            const CompiledModel& _model;
+            const Services&      _services;
+    };
+};
+
+#endif
@@ -25,11 +25,13 @@
 ///////////////////////////////////////////////////////////////////////////
 // roadef12
 #include "roadef12-common/service/ServiceExceptions.hpp"
-#include "roadef12-common/Types.hpp"
-#include "roadef12-common/objects/Assignment.hpp"
 #include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/ProcessRange.hpp"
+#include "roadef12-common/objects/ServiceMoveTracker.hpp"
+#include "roadef12-common/objects/ServicePlacement.hpp"
+#include "roadef12-common/objects/SlackIndex.hpp"
+#include "roadef12-common/commands/FileParser.hpp"
 #include "roadef12-common/util/Util.hpp"
-#include "roadef12-common/Types.hpp"
 ///////////////////////////////////////////////////////////////////////////
 // BOOST
 #include <boost/lexical_cast.hpp>
@@ -37,8 +39,9 @@
 ///////////////////////////////////////////////////////////////////////////
 // STD
 #include <stdexcept>
-#include <list>
-#include <set>
+#include <vector>
+#include <algorithm>
+#include <numeric>
 #include <fstream>
 ///////////////////////////////////////////////////////////////////////////
 namespace ROADEF12COMMON
@@ -48,10 +51,13 @@ namespace ROADEF12COMMON
     /**
      * Process to machine assignments. All operations are constant time
      * except for the parsing method since it pre-computes some values
-     * (processes per machine, per service,...).
+     * (processes per machine, per service,...). The parsed assignment
+     * is the original one: processes moved away from their original
+     * machine keep using its transient resources. Storage is sized after
+     * the parameters, so assignments are cheap to copy and assign; the
+     * parameters must outlive them.
      *
      * @author daniperez
-     * @todo   Adjust the size of the arrays (using powers of 2 so far)
      */
     class Assignment
     {   
@@ -73,55 +79,78 @@ namespace ROADEF12COMMON
              */ 
             Assignment ( const char* fileName, const Parameters& parameters )
             throw ( ROADEF12COMMON::IOException, ROADEF12COMMON::ParseException )
-                : _parameters ( parameters )
+                : _parameters ( &parameters ),
+                  _processToMachine ( parameters.processes.size() ),
+                  _machineToProcess ( parameters.machines.size() ),
+                  _machineLoad ( parameters.machines.size() *
+                                 parameters.resources.size(), 0 ),
+                  _originalMachine ( parameters.processes.size() ),
+                  _slot ( parameters.processes.size() ),
+                  _serviceToProcess ( parameters.processes.size() ),
+                  _serviceOffset ( parameters.services.size() + 1, 0 ),
+                  _transientLoad ( parameters.machines.size() *
+                                   parameters.resources.size(), 0 ),
+                  _placement ( parameters.services.size(),
+                               parameters.compiled.getNumLocations(),
+                               parameters.compiled.getNumNeighborhoods() ),
+                  _movedPerService ( parameters.services.size(),
+                                     parameters.processes.size() ),
+                  _slack ( parameters.machines.size(),
+                           parameters.resources.size() ),
+                  _journaling ( false )
             {
-                Util::throwing_assert ( fileName != NULL );
-                
-                std::ifstream file ( fileName, std::ios::in );
-                
-                if ( file.fail() )
+                std::vector<int> machines;
+
+                FileParser::parseVectorMapped ( fileName, machines );
+
+                if ( machines.size() != _parameters->processes.size() )
                 {
-                    throw ROADEF12COMMON::IOException
+                    throw ROADEF12COMMON::ParseException
                     (
-                        (
-                            std::string ( "'" ) + fileName +
-                            std::string ( "' cannot be open" )
-                        ).c_str()
+                        (std::string(fileName) +
+                            std::string (" has a wrong number of processes")).c_str()
                     );
                 }
 
-                ushort machine = 0;
-                ushort process = 0;
-                
-                while ( file >> machine )
+                for ( uint process = 0 ; process < machines.size() ; ++process )
                 {
-                    _processToMachine[process] = machine ;
-                    _machineToProcess[machine].push_back(process);
-                    _serviceToProcess[_parameters.processes.getService(process)].push_back(process);
-                    ++process;
-                    
-                    if ( file.fail() )
+                    if ( machines [ process ] < 0 ||
+                         uint ( machines [ process ] ) >= _parameters->machines.size() )
                     {
-                        throw ROADEF12COMMON::IOException
+                        throw ROADEF12COMMON::ParseException
                         (
                             (std::string(fileName) +
-                                std::string (" cannot be read")).c_str()
+                                std::string (" assigns process ") +
+                                boost::lexical_cast<std::string> ( process ) +
+                                std::string (" to a machine that doesn't exist")).c_str()
                         );
                     }
+
+                    ushort machine = machines [ process ];
+
+                    _processToMachine[process] = machine ;
+                    _originalMachine[process] = machine ;
+                    addToMachine ( process, machine );
+                    ++_serviceOffset[_parameters->compiled.getService(process) + 1];
                 }
 
-                file.clear();
-                file.close();
-                
-                if ( file.fail() )
+                // Processes never change service: the per-service index
+                // is built once, processes of service s being stored in
+                // [_serviceOffset[s], _serviceOffset[s+1]).
+                std::partial_sum ( _serviceOffset.begin(),
+                                   _serviceOffset.end(),
+                                   _serviceOffset.begin() );
+
+                std::vector<uint> next ( _serviceOffset.begin(),
+                                         _serviceOffset.end() - 1 );
+
+                for ( uint process = 0 ; process < machines.size() ; ++process )
                 {
-                    throw ROADEF12COMMON::IOException
-                    (
-                        (std::string(fileName) +
-                            std::string (" cannot be closed")).c_str()
-                    );
+                    _serviceToProcess
+                        [ next [ _parameters->compiled.getService(process) ]++ ]
+                        = process;
                 }
-                
+
                 postProcess();
             }
 
@@ -141,24 +170,28 @@ namespace ROADEF12COMMON
             ushort
             getMachine ( ushort processId ) const
             {
-                Util::throwing_assert ( processId < _parameters.processes.size() ) ;
+                Util::throwing_assert ( processId < _parameters->processes.size() ) ;
                 
                 return _processToMachine [ processId ] ;
             }
 
             /**
-             * Returns the processes corresponding to the given machine.
-             * O(1).
+             * Returns the processes corresponding to the given machine,
+             * in no particular order. O(1).
              * 
              * @param machineId Machine's id.
-             * @return list of process ids of the given machine.
+             * @return View of the process ids of the given machine, valid
+             *         until the assignment changes.
              */
-            const std::list<ushort>&
+            ProcessRange
             getProcessesPerMachine ( ushort machineId ) const
             {
-                Util::throwing_assert ( machineId < _parameters.machines.size() ) ;
+                Util::throwing_assert ( machineId < _parameters->machines.size() ) ;
+
+                const std::vector<ushort>& procs = _machineToProcess [ machineId ];
 
-                return _machineToProcess [ machineId ];
+                return ProcessRange ( procs.empty() ? NULL : &procs[0],
+                                      procs.size() );
             }
 
             /**
@@ -174,10 +207,75 @@ namespace ROADEF12COMMON
             const uint
             getUtilization ( ushort machine, ushort resource ) const
             {
-                Util::throwing_assert ( machine < _parameters.machines.size() ) ;
-                Util::throwing_assert ( resource < _parameters.resources.size() ) ;
+                Util::throwing_assert ( machine < _parameters->machines.size() ) ;
+                Util::throwing_assert ( resource < _parameters->resources.size() ) ;
+
+                return _machineLoad [ machine*_parameters->resources.size() +
+                                      resource ] ;
+            }
+
+            /**
+             * Returns the machine utilization of every resource. O(1).
+             *
+             * @param machine Machine's id.
+             * @return Row of R loads, indexed by resource.
+             */
+            const uint*
+            getUtilizations ( ushort machine ) const
+            {
+                Util::throwing_assert ( machine < _parameters->machines.size() ) ;
+
+                return &_machineLoad [ machine*_parameters->resources.size() ] ;
+            }
+
+            /**
+             * Returns the usage of a transient resource kept on the given
+             * machine by the processes that were originally there and
+             * have been moved away. O(1).
+             *
+             * @param machine Machine's id.
+             * @param resource Resource id.
+             * @return Transient load of the machine, 0 for non-transient
+             *         resources.
+             */
+            const uint
+            getTransientUtilization ( ushort machine, ushort resource ) const
+            {
+                Util::throwing_assert ( machine < _parameters->machines.size() ) ;
+                Util::throwing_assert ( resource < _parameters->resources.size() ) ;
 
-                return _machineLoad [ machine ] [ resource ] ;
+                return _transientLoad [ machine*_parameters->resources.size() +
+                                        resource ] ;
+            }
+
+            /**
+             * Returns the transient usage kept on the given machine for
+             * every resource. O(1).
+             *
+             * @param machine Machine's id.
+             * @return Row of R loads, indexed by resource.
+             */
+            const uint*
+            getTransientUtilizations ( ushort machine ) const
+            {
+                Util::throwing_assert ( machine < _parameters->machines.size() ) ;
+
+                return &_transientLoad [ machine*_parameters->resources.size() ] ;
+            }
+
+            /**
+             * Returns the machine the given process was originally
+             * assigned to. O(1).
+             *
+             * @param processId Process' id.
+             * @return Original machine of the process.
+             */
+            ushort
+            getOriginalMachine ( ushort processId ) const
+            {
+                Util::throwing_assert ( processId < _parameters->processes.size() ) ;
+
+                return _originalMachine [ processId ] ;
             }
 
             /**
@@ -185,16 +283,79 @@ namespace ROADEF12COMMON
              * O(1).
              * 
              * @param serviceId Service's id.
-             * @return list of process ids of the given service.
+             * @return View of the process ids of the given service.
              */
-            const std::list<ushort>&
+            ProcessRange
             getProcessesPerService ( ushort serviceId ) const
             {
-                Util::throwing_assert ( serviceId < _parameters.services.size() ) ;
+                Util::throwing_assert ( serviceId < _parameters->services.size() ) ;
+
+                const uint first = _serviceOffset [ serviceId ];
 
-                return _serviceToProcess [ serviceId ];
+                return ProcessRange ( &_serviceToProcess[0] + first,
+                                      _serviceOffset [ serviceId + 1 ] - first );
             }
              
+            /**
+             * Returns the number of processes of the given service that
+             * are not on their original machine. O(1).
+             *
+             * @param serviceId Service's id.
+             * @return Number of moved processes.
+             */
+            uint
+            getNumMovedProcesses ( ushort serviceId ) const
+            {
+                Util::throwing_assert ( serviceId < _parameters->services.size() ) ;
+
+                return _movedPerService.get ( serviceId ) ;
+            }
+
+            /**
+             * Returns the moved processes per service, see
+             * ServiceMoveTracker.
+             *
+             * @return Tracker.
+             */
+            const ServiceMoveTracker&
+            getServiceMoveTracker () const
+            {
+                return _movedPerService ;
+            }
+
+            /**
+             * Returns the number of processes of the given service in the
+             * given location. O(1).
+             *
+             * @param serviceId Service's id.
+             * @param location Location's id.
+             * @return Number of processes.
+             */
+            uint
+            getNumProcessesInLocation ( ushort serviceId, uint location ) const
+            {
+                Util::throwing_assert ( serviceId < _parameters->services.size() ) ;
+
+                return _placement.getInLocation ( serviceId, location );
+            }
+
+            /**
+             * Returns the number of processes of the given service in the
+             * given neighborhood. O(1).
+             *
+             * @param serviceId Service's id.
+             * @param neighborhood Neighborhood's id.
+             * @return Number of processes.
+             */
+            uint
+            getNumProcessesInNeighborhood ( ushort serviceId,
+                                            uint neighborhood ) const
+            {
+                Util::throwing_assert ( serviceId < _parameters->services.size() ) ;
+
+                return _placement.getInNeighborhood ( serviceId, neighborhood );
+            }
+
             /**
              * Returns the number of different locations corresponding to
              * the given service. O(1).
@@ -205,9 +366,72 @@ namespace ROADEF12COMMON
             const ushort
             getNumLocationsPerService ( ushort serviceId ) const
             {
-                Util::throwing_assert ( serviceId < _parameters.services.size() ) ;
+                Util::throwing_assert ( serviceId < _parameters->services.size() ) ;
 
-                return _serviceToNumLocations [ serviceId ] ;
+                return _placement.getNumLocations ( serviceId ) ;
+            }
+
+            /**
+             * Returns the remaining capacity of the machines, see
+             * SlackIndex.
+             *
+             * @return Index.
+             */
+            const SlackIndex&
+            getSlackIndex () const
+            {
+                return _slack ;
+            }
+
+            /**
+             * Finds the machines, other than its current one, with enough
+             * remaining capacity (transient usage included) to host the
+             * process. The original machine of a moved process counts the
+             * transient usage the process keeps there as free. Sublinear
+             * in M, see SlackIndex.
+             *
+             * @param processId Process' id.
+             * @param output Array of M machine ids to fill in.
+             * @return Number of machines written, in no particular order.
+             */
+            uint
+            findFittingMachines ( ushort processId, ushort* output ) const
+            {
+                Util::throwing_assert ( processId < _parameters->processes.size() ) ;
+
+                const CompiledModel& model        = _parameters->compiled;
+                const int*           requirements = model.getRequirements ( processId );
+                const ushort         current      = _processToMachine [ processId ];
+                const ushort         original     = _originalMachine [ processId ];
+
+                uint found = _slack.findFits ( requirements, output );
+
+                if ( _slack.fits ( current, requirements ) )
+                {
+                    *std::find ( output, output + found, current ) = output [ found-1 ];
+                    --found;
+                }
+
+                if ( current != original &&
+                     ! _slack.fits ( original, requirements ) )
+                {
+                    const int* slack     = _slack.getSlacks ( original );
+                    const int* transient = model.getTransientFlags ();
+                    bool       fits      = true;
+
+                    for ( uint r = 0 ; r < model.getNumResources() && fits ; ++r )
+                    {
+                        fits = slack [ r ] + transient [ r ] * requirements [ r ] >=
+                               requirements [ r ];
+                    }
+
+                    if ( fits )
+                    {
+                        output [ found++ ] = original;
+                    }
+                }
+
+                return found;
             }
             ///@}
 
@@ -218,8 +442,11 @@ namespace ROADEF12COMMON
              */
             ///@{
             /**
-             * Moves a process from the original machine to the
-             * new given machine.
+             * Moves a process from its current machine to the
+             * new given machine. Loads, transient usage, slack and
+             * locations per service are updated in O(R), the process
+             * index of the
+             * machines in O(1).
              *
              * @param process Process to migrate.
              * @param newMachine Machine to move the process to.
@@ -227,7 +454,149 @@ namespace ROADEF12COMMON
             void
             move ( uint process, uint newMachine )
             {
-                // TODO
+                Util::throwing_assert ( process < _parameters->processes.size() ) ;
+                Util::throwing_assert ( newMachine < _parameters->machines.size() ) ;
+
+                const ushort oldMachine = _processToMachine [ process ];
+
+                if ( oldMachine == newMachine )
+                {
+                    return;
+                }
+
+                const ushort service = _parameters->compiled.getService ( process );
+
+                record ( process, oldMachine );
+
+                removeAssignment ( service, process, oldMachine );
+
+                removeFromMachine ( process, oldMachine );
+                addToMachine ( process, newMachine );
+                _processToMachine [ process ] = newMachine;
+
+                addAssignment ( service, process, newMachine );
+
+                trackOriginalMachine ( process, oldMachine, newMachine );
+
+                updateSlack ( oldMachine );
+                updateSlack ( newMachine );
+            }
+
+            /**
+             * Exchanges the machines of two processes as a single
+             * operation: the loads of both machines are updated in one
+             * O(R) pass, so no intermediate state with one of the
+             * processes counted twice is ever built.
+             *
+             * @param process1 First process.
+             * @param process2 Second process.
+             */
+            void
+            swap ( uint process1, uint process2 )
+            {
+                Util::throwing_assert ( process1 < _parameters->processes.size() ) ;
+                Util::throwing_assert ( process2 < _parameters->processes.size() ) ;
+
+                const ushort machine1 = _processToMachine [ process1 ];
+                const ushort machine2 = _processToMachine [ process2 ];
+
+                if ( machine1 == machine2 )
+                {
+                    return;
+                }
+
+                const ushort service1 = _parameters->compiled.getService ( process1 );
+                const ushort service2 = _parameters->compiled.getService ( process2 );
+
+                record ( process1, machine1 );
+                record ( process2, machine2 );
+
+                updateServicePlacement ( service1, machine1, -1 );
+                updateServicePlacement ( service2, machine2, -1 );
+                updateServicePlacement ( service1, machine2, 1 );
+                updateServicePlacement ( service2, machine1, 1 );
+
+                exchangeMachineLoad ( process1, machine1, process2, machine2 );
+
+                // Each process takes the other's slot
+                _machineToProcess [ machine1 ] [ _slot [ process1 ] ] = process2;
+                _machineToProcess [ machine2 ] [ _slot [ process2 ] ] = process1;
+                std::swap ( _slot [ process1 ], _slot [ process2 ] );
+                _processToMachine [ process1 ] = machine2;
+                _processToMachine [ process2 ] = machine1;
+
+                trackOriginalMachine ( process1, machine1, machine2 );
+                trackOriginalMachine ( process2, machine2, machine1 );
+
+                updateSlack ( machine1 );
+                updateSlack ( machine2 );
+            }
+            ///@}
+
+        public:
+
+            /**
+             * @name Transactions.
+             *
+             * Moves done between begin() and commit() or rollback() are
+             * journaled as (process, previous machine) so that rollback()
+             * undoes them in time proportional to the number of moves,
+             * instead of copying the assignment. Transactions don't nest.
+             */
+            ///@{
+            /**
+             * Starts journaling the changes.
+             */
+            void
+            begin ()
+            {
+                Util::throwing_assert ( ! _journaling ) ;
+
+                _journal.clear ();
+                _journaling = true;
+            }
+
+            /**
+             * Keeps the changes done since begin().
+             */
+            void
+            commit ()
+            {
+                Util::throwing_assert ( _journaling ) ;
+
+                _journal.clear ();
+                _journaling = false;
+            }
+
+            /**
+             * Undoes the changes done since begin(), latest first.
+             */
+            void
+            rollback ()
+            {
+                Util::throwing_assert ( _journaling ) ;
+
+                _journaling = false;
+
+                while ( ! _journal.empty () )
+                {
+                    const JournalEntry& entry = _journal.back ();
+
+                    move ( entry.process, entry.machine );
+
+                    _journal.pop_back ();
+                }
+            }
+
+            /**
+             * Says if a transaction is in progress.
+             *
+             * @return True between begin() and commit() or rollback().
+             */
+            bool
+            inTransaction () const
+            {
+                return _journaling;
             }
             ///@}
 
@@ -247,7 +616,7 @@ namespace ROADEF12COMMON
             {
                 std::string output;
                 
-                for ( ushort i = 0 ; i < _parameters.processes.size() ; ++i )
+                for ( ushort i = 0 ; i < _parameters->processes.size() ; ++i )
                 {
                     output += "M(" ;
                     output += boost::lexical_cast<std::string> ( i ) ;
@@ -273,7 +642,7 @@ namespace ROADEF12COMMON
             {
                 std::ofstream output ( fileName, std::ios::out );
 
-                for ( uint i = 0; i < _parameters.processes.size() ; ++i )
+                for ( uint i = 0; i < _parameters->processes.size() ; ++i )
                 {
                     if ( i > 0 )
                     {
@@ -289,126 +658,334 @@ namespace ROADEF12COMMON
                     
             /**
              * Processes a just-parsed assignment. We pre-calculate
-             * some data used frequently. O(num_services*num_procs).
+             * some data used frequently. O(num_procs*num_resources).
              */
             void
             postProcess ()
             {
-                for ( ushort serviceId = 0;
-                      serviceId < _parameters.services.size();
-                      ++serviceId )
+                std::fill ( _machineLoad.begin(), _machineLoad.end(), 0 );
+                std::fill ( _transientLoad.begin(), _transientLoad.end(), 0 );
+                _movedPerService.clear ();
+                _placement.clear ();
+
+                for ( uint proc = 0;
+                      proc < _parameters->processes.size();
+                      ++proc )
                 {
-                    const std::list<ushort>& procs
-                        = getProcessesPerService ( serviceId );
-                    
-                    std::set<ushort> locations;    
-                        
-                    BOOST_FOREACH ( ushort proc, procs )
+                    addAssignment ( _parameters->compiled.getService ( proc ),
+                                    proc,
+                                    getMachine ( proc ) );
+
+                    if ( getMachine ( proc ) != _originalMachine [ proc ] )
                     {
-                        ushort machineId
-                            = getMachine ( proc );
-                        
-                        updateAssignment
-                            ( serviceId, proc, machineId, locations );
+                        updateMoved ( proc, 1 );
                     }
                 }
+
+                for ( uint machine = 0;
+                      machine < _parameters->machines.size();
+                      ++machine )
+                {
+                    updateSlack ( machine );
+                }
             }
 
             /**
-             * Updates the structures depending on an assignment such
-             * as utilization and locations per service.
+             * Journals the machine a process is about to leave, if a
+             * transaction is in progress.
+             *
+             * @param process Process.
+             * @param machine Machine the process is currently assigned to.
+             */
+            void
+            record ( ushort process, ushort machine )
+            {
+                if ( _journaling )
+                {
+                    JournalEntry entry = { process, machine };
+
+                    _journal.push_back ( entry );
+                }
+            }
+
+            /**
+             * Appends the process to the machine's index.
              *
-             * @param service Service.
              * @param process Process.
              * @param machine Machine.
-             * @param locations Set of locations already processed. Pass
-             *        an empty one if none was processes yet.
              */
             void
-            updateAssignment
-            (
-                ushort service,
-                ushort process,
-                ushort machine,
-                std::set<ushort>& locations
-            )
+            addToMachine ( ushort process, ushort machine )
             {
-                updateServiceLocations ( service, process, machine, locations );
-                updateMachineLoad ( process, machine );
+                std::vector<ushort>& procs = _machineToProcess [ machine ];
+
+                _slot [ process ] = procs.size();
+                procs.push_back ( process );
             }
 
             /**
-             * Updates the locations per service.
+             * Removes the process from the machine's index in O(1): the
+             * last process of the machine takes its slot.
              *
-             * @param service Service.
+             * @param process Process.
+             * @param machine Machine the process is assigned to.
+             */
+            void
+            removeFromMachine ( ushort process, ushort machine )
+            {
+                std::vector<ushort>& procs = _machineToProcess [ machine ];
+                const ushort         last  = procs.back ();
+                const ushort         slot  = _slot [ process ];
+
+                procs [ slot ] = last;
+                _slot [ last ] = slot;
+                procs.pop_back ();
+            }
+
+            /**
+             * Accounts for the given process running on the given machine:
+             * utilization, transient usage and locations per service.
+             *
+             * @param service Service of the process.
              * @param process Process.
              * @param machine Machine.
-             * @param locations Set of locations already processed. Pass
-             *        an empty one if none was processes yet.
              */
             void
-            updateServiceLocations
-            (
-                ushort service,
-                ushort process,
-                ushort machine,
-                std::set<ushort>& locations
-            )
+            addAssignment ( ushort service, ushort process, ushort machine )
             {
-                Util::throwing_assert ( service < _parameters.services.size() ) ;
-                Util::throwing_assert ( process < _parameters.processes.size() ) ;
-                Util::throwing_assert ( machine < _parameters.machines.size() ) ;
+                Util::throwing_assert ( service < _parameters->services.size() ) ;
+                Util::throwing_assert ( process < _parameters->processes.size() ) ;
+                Util::throwing_assert ( machine < _parameters->machines.size() ) ;
 
-                int location
-                    = _parameters.machines.getLocation ( machine );
+                updateServicePlacement ( service, machine, 1 );
+                updateMachineLoad ( process, machine, 1 );
+            }
 
-                std::set<ushort>::iterator it;
+            /**
+             * Reverse of addAssignment.
+             *
+             * @param service Service of the process.
+             * @param process Process.
+             * @param machine Machine.
+             */
+            void
+            removeAssignment ( ushort service, ushort process, ushort machine )
+            {
+                Util::throwing_assert ( service < _parameters->services.size() ) ;
+                Util::throwing_assert ( process < _parameters->processes.size() ) ;
+                Util::throwing_assert ( machine < _parameters->machines.size() ) ;
 
-                if ( (it = locations.find ( location )) == locations.end() )
+                updateServicePlacement ( service, machine, -1 );
+                updateMachineLoad ( process, machine, -1 );
+            }
+
+            /**
+             * Adds (sign=1) or removes (sign=-1) one process of the service
+             * to the location and neighborhood of the given machine. O(1).
+             *
+             * @param service Service.
+             * @param machine Machine.
+             * @param sign 1 or -1.
+             */
+            void
+            updateServicePlacement ( ushort service, ushort machine, int sign )
+            {
+                const uint location
+                    = _parameters->compiled.getLocation ( machine );
+                const uint neighborhood
+                    = _parameters->compiled.getNeighborhood ( machine );
+
+                if ( sign > 0 )
                 {
-                    locations.insert ( it, location );
-                                                
-                    _serviceToNumLocations [ service ] += locations.size();
+                    _placement.add ( service, location, neighborhood );
+                }
+                else
+                {
+                    _placement.remove ( service, location, neighborhood );
                 }
             }
 
             /**
-             * Updates the machine's load with the resource consumption of the
-             * given process.
+             * Adds (sign=1) or removes (sign=-1) the resource consumption of
+             * the given process to the machine's load.
              *
              * @param process Process.
              * @param machine Machine.
+             * @param sign 1 or -1.
              */
             void
-            updateMachineLoad ( ushort process, ushort machine )
+            updateMachineLoad ( ushort process, ushort machine, int sign )
             {
-                Util::throwing_assert ( process < _parameters.processes.size() ) ;
-                Util::throwing_assert ( machine < _parameters.machines.size() ) ;
+                Util::throwing_assert ( process < _parameters->processes.size() ) ;
+                Util::throwing_assert ( machine < _parameters->machines.size() ) ;
+
+                const int* requirements
+                    = _parameters->compiled.getRequirements ( process );
+                const uint numResources
+                    = _parameters->compiled.getNumResources ();
+                uint*      load = &_machineLoad [ machine*numResources ];
 
-                for ( ushort
-                      resource = 0;
-                      resource < _parameters.resources.size();
-                      ++resource )
+                for ( uint resource = 0 ; resource < numResources ; ++resource )
+                {
+                    load [ resource ] += sign * requirements [ resource ];
+                }
+            }
+
+            /**
+             * Moves the resource consumption of process1 from machine1 to
+             * machine2 and the one of process2 the other way round.
+             *
+             * @param process1 Process currently on machine1.
+             * @param machine1 Machine.
+             * @param process2 Process currently on machine2.
+             * @param machine2 Machine.
+             */
+            void
+            exchangeMachineLoad ( ushort process1, ushort machine1,
+                                  ushort process2, ushort machine2 )
+            {
+                const int* requirements1
+                    = _parameters->compiled.getRequirements ( process1 );
+                const int* requirements2
+                    = _parameters->compiled.getRequirements ( process2 );
+                const uint numResources
+                    = _parameters->compiled.getNumResources ();
+                uint*      load1 = &_machineLoad [ machine1*numResources ];
+                uint*      load2 = &_machineLoad [ machine2*numResources ];
+
+                for ( uint resource = 0 ; resource < numResources ; ++resource )
+                {
+                    const int delta
+                        = requirements2 [ resource ] - requirements1 [ resource ];
+
+                    load1 [ resource ] += delta;
+                    load2 [ resource ] -= delta;
+                }
+            }
+
+            /**
+             * Updates the transient usage of the original machine of the
+             * given process and the number of moved processes of its
+             * service after it moved from oldMachine to newMachine.
+             *
+             * @param process Process.
+             * @param oldMachine Machine the process left.
+             * @param newMachine Machine the process is now assigned to.
+             */
+            void
+            trackOriginalMachine ( ushort process,
+                                    ushort oldMachine,
+                                    ushort newMachine )
+            {
+                const ushort original = _originalMachine [ process ];
+
+                if ( oldMachine == original )
+                {
+                    updateMoved ( process, 1 );
+                }
+                else if ( newMachine == original )
                 {
-                    // TODO: this shouldn't go into objects. 
-                    _machineLoad[machine][resource] +=
-                        _parameters.processes.getRequirement ( process, resource );
+                    updateMoved ( process, -1 );
                 }
             }
 
+            /**
+             * Marks the process as moved away from (sign=1) or back
+             * to (sign=-1) its original machine.
+             *
+             * @param process Process.
+             * @param sign 1 or -1.
+             */
+            void
+            updateMoved ( ushort process, int sign )
+            {
+                updateTransientLoad ( process, sign );
+
+                _movedPerService.update ( _parameters->compiled.getService ( process ),
+                                          sign );
+            }
+
+            /**
+             * Adds (sign=1) or removes (sign=-1) the transient resource
+             * consumption of the given process to its original machine,
+             * i.e. when the process leaves it or comes back to it.
+             *
+             * @param process Process.
+             * @param sign 1 or -1.
+             */
+            void
+            updateTransientLoad ( ushort process, int sign )
+            {
+                const CompiledModel& model = _parameters->compiled;
+                const int* requirements    = model.getRequirements ( process );
+                const int* transient       = model.getTransientFlags ();
+                const uint numResources    = model.getNumResources ();
+                uint*      load            = &_transientLoad
+                                             [ _originalMachine [ process ] *
+                                               numResources ];
+
+                for ( uint resource = 0 ; resource < numResources ; ++resource )
+                {
+                    load [ resource ] +=
+                        sign * transient [ resource ] * requirements [ resource ];
+                }
+            }
+
+            /**
+             * Refreshes the remaining capacity of the machine in the
+             * slack index. O(R).
+             *
+             * @param machine Machine whose load or transient usage changed.
+             */
+            void
+            updateSlack ( ushort machine )
+            {
+                _slack.update ( machine,
+                                _parameters->compiled.getCapacities ( machine ),
+                                getUtilizations ( machine ),
+                                getTransientUtilizations ( machine ) );
+            }
+
+        private:
+
+            /**
+             * Undo information of a move.
+             */
+            struct JournalEntry
+            {
+                ushort process;
+                ushort machine;
+            };
+
         private:
             
-            const Parameters&  _parameters;
-            /** */
-            ushort             _processToMachine[MAX_NUM_PROCESSES];
-            /** */
-            std::list<ushort>  _machineToProcess[MAX_NUM_MACHINES];
-            /** */
-            uint               _machineLoad[MAX_NUM_MACHINES][MAX_NUM_RESOURCES];
+            const Parameters*   _parameters;
             /** */
-            std::list<ushort>  _serviceToProcess[MAX_NUM_SERVICES];
+            std::vector<ushort> _processToMachine;
             /** */
-            ushort             _serviceToNumLocations[MAX_NUM_SERVICES];
+            std::vector< std::vector<ushort> > _machineToProcess;
+            /** Utilization, [M][R]. */
+            std::vector<uint>   _machineLoad;
+            /** Machine of each process in the parsed assignment. */
+            std::vector<ushort> _originalMachine;
+            /** Position of each process in its machine's index. */
+            std::vector<ushort> _slot;
+            /** Processes grouped by service, see _serviceOffset. */
+            std::vector<ushort> _serviceToProcess;
+            /** Start of each service in _serviceToProcess, [S+1]. */
+            std::vector<uint>   _serviceOffset;
+            /** Transient usage kept on the original machines, [M][R]. */
+            std::vector<uint>   _transientLoad;
+            /** Processes per (service, location) and (service, neighborhood). */
+            ServicePlacement    _placement;
+            /** Processes not on their original machine, per service. */
+            ServiceMoveTracker  _movedPerService;
+            /** Remaining capacity per machine, indexed for fit queries. */
+            SlackIndex          _slack;
+            /** Moves done in the current transaction. */
+            std::vector<JournalEntry> _journal;
+            /** True inside begin()/commit() or rollback(). */
+            bool                _journaling;
     };
 };
 
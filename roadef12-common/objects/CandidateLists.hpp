@@ -0,0 +1,396 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_CANDIDATE_LISTS_HPP
+#define __roadef12_CANDIDATE_LISTS_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/ProcessRange.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Machine ids viewed the same way as process ids.
+     */
+    typedef ProcessRange MachineRange;
+
+    /**
+     * Per-process list of the machines that pass the static filters, i.e.
+     * the ones that don't depend on the assignment:
+     *   - capacity: the machine can hold the process alone;
+     *   - dependency: for every service the process' service depends on,
+     *     some process of that service fits alone on a machine of the
+     *     same neighborhood.
+     * A machine failing them can't host the process in any feasible
+     * assignment, so move generators iterate the list instead of the M
+     * machines. Lists are sorted by machine id and stored in a single
+     * CSR array. They are built in parallel, by chunks of processes.
+     *
+     * @author daniperez
+     */
+    class CandidateLists
+    {
+        public:
+
+            /**
+             * Constructor. Builds the lists.
+             *
+             * @param parameters Parameters.
+             * @param numThreads Number of threads building the lists, 0 to
+             *        use the available hardware threads.
+             */
+            CandidateLists ( const Parameters& parameters,
+                             uint numThreads = 0 )
+                : _model ( parameters.compiled ),
+                  _services ( parameters.services ),
+                  _offset ( _model.getNumProcesses() + 1, 0 ),
+                  _milliseconds ( 0 )
+            {
+                build ( numThreads );
+            }
+
+        public:
+
+            /**
+             * Machines that may host the process.
+             *
+             * @param process Process' id.
+             * @return View of machine ids, in increasing order.
+             */
+            MachineRange
+            getCandidates ( uint process ) const
+            {
+                return MachineRange ( _machines.empty() ? NULL :
+                                          &_machines [ _offset [ process ] ],
+                                      _offset [ process+1 ] - _offset [ process ] );
+            }
+
+            /**
+             * Says if the machine is a candidate of the process. Binary
+             * search in its list, O(log candidates).
+             *
+             * @param process Process' id.
+             * @param machine Machine's id.
+             * @return True if the machine is in the list of the process.
+             */
+            bool
+            isCandidate ( uint process, uint machine ) const
+            {
+                const MachineRange candidates = getCandidates ( process );
+
+                return std::binary_search ( candidates.begin(), candidates.end(),
+                                            ushort ( machine ) );
+            }
+
+            /**
+             * Says if the dependency filter lets the service's processes
+             * run in the neighborhood.
+             *
+             * @param service Service's id.
+             * @param neighborhood Neighborhood's id.
+             * @return True if allowed.
+             */
+            bool
+            isAllowed ( uint service, uint neighborhood ) const
+            {
+                return _allowed [ service*_model.getNumNeighborhoods() +
+                                  neighborhood ];
+            }
+
+            /**
+             * Total number of candidates, summed over the processes.
+             *
+             * @return Size of the lists.
+             */
+            size_t
+            size () const
+            {
+                return _machines.size();
+            }
+
+            /**
+             * Wall-clock time the construction took.
+             *
+             * @return Milliseconds.
+             */
+            uint
+            getBuildTime () const
+            {
+                return _milliseconds;
+            }
+
+        protected:
+
+            /**
+             * Candidates of a chunk of processes, before concatenation.
+             */
+            struct Chunk
+            {
+                /** First process of the chunk. */
+                uint                first;
+                /** Past-the-end process of the chunk. */
+                uint                last;
+                /** Candidates of the chunk's processes, one after another. */
+                std::vector<ushort> machines;
+                /** Number of candidates per process of the chunk. */
+                std::vector<uint>   count;
+            };
+
+            /**
+             * Builds the lists: the capacity filter per chunk, in
+             * parallel; the neighborhoods allowed per service from its
+             * result; the dependency filter per chunk, in parallel; and
+             * the concatenation of the chunks.
+             *
+             * @param numThreads Number of threads, 0 for the hardware's.
+             */
+            void
+            build ( uint numThreads )
+            {
+                const std::chrono::steady_clock::time_point start
+                    = std::chrono::steady_clock::now();
+
+                const uint numProcesses = _model.getNumProcesses();
+
+                if ( numThreads == 0 )
+                {
+                    numThreads = std::max ( 1u, std::thread::hardware_concurrency() );
+                }
+
+                numThreads = std::max ( 1u, std::min ( numThreads, numProcesses ) );
+
+                std::vector<Chunk> chunks ( numThreads );
+
+                for ( uint t = 0 ; t < numThreads ; ++t )
+                {
+                    chunks [ t ].first = uint ( uint64_t ( numProcesses ) * t / numThreads );
+                    chunks [ t ].last  = uint ( uint64_t ( numProcesses ) * ( t+1 ) / numThreads );
+                }
+
+                runInParallel ( chunks, &CandidateLists::filterCapacity );
+
+                computeAllowedNeighborhoods ( chunks );
+
+                runInParallel ( chunks, &CandidateLists::filterDependencies );
+
+                for ( uint t = 0 ; t < numThreads ; ++t )
+                {
+                    const Chunk& chunk = chunks [ t ];
+
+                    for ( uint p = chunk.first ; p < chunk.last ; ++p )
+                    {
+                        _offset [ p+1 ] = _offset [ p ] + chunk.count [ p - chunk.first ];
+                    }
+                }
+
+                _machines.reserve ( _offset [ numProcesses ] );
+
+                for ( uint t = 0 ; t < numThreads ; ++t )
+                {
+                    _machines.insert ( _machines.end(),
+                                       chunks [ t ].machines.begin(),
+                                       chunks [ t ].machines.end() );
+                }
+
+                _milliseconds
+                    = std::chrono::duration_cast<std::chrono::milliseconds>
+                          ( std::chrono::steady_clock::now() - start ).count();
+            }
+
+            /**
+             * Runs the step on every chunk, one thread per chunk (the first
+             * one in the calling thread).
+             *
+             * @param chunks Chunks.
+             * @param step Member function processing one chunk.
+             */
+            void
+            runInParallel ( std::vector<Chunk>& chunks,
+                            void ( CandidateLists::*step ) ( Chunk& ) const ) const
+            {
+                std::vector<std::thread> threads;
+
+                for ( uint t = 1 ; t < chunks.size() ; ++t )
+                {
+                    threads.push_back ( std::thread ( step, this,
+                                                      std::ref ( chunks [ t ] ) ) );
+                }
+
+                ( this->*step ) ( chunks [ 0 ] );
+
+                for ( uint t = 0 ; t < threads.size() ; ++t )
+                {
+                    threads [ t ].join();
+                }
+            }
+
+            /**
+             * Capacity filter: machines where the process fits alone.
+             * O(M*R) per process.
+             *
+             * @param chunk Chunk to fill in.
+             */
+            void
+            filterCapacity ( Chunk& chunk ) const
+            {
+                const uint numMachines  = _model.getNumMachines();
+                const uint numResources = _model.getNumResources();
+
+                chunk.count.assign ( chunk.last - chunk.first, 0 );
+
+                for ( uint p = chunk.first ; p < chunk.last ; ++p )
+                {
+                    const int* requirements = _model.getRequirements ( p );
+
+                    for ( uint m = 0 ; m < numMachines ; ++m )
+                    {
+                        const int* capacities = _model.getCapacities ( m );
+
+                        bool fits = true;
+
+                        for ( uint r = 0 ; r < numResources && fits ; ++r )
+                        {
+                            fits = requirements [ r ] <= capacities [ r ];
+                        }
+
+                        if ( fits )
+                        {
+                            chunk.machines.push_back ( m );
+                            ++chunk.count [ p - chunk.first ];
+                        }
+                    }
+                }
+            }
+
+            /**
+             * Neighborhoods allowed per service: the ones where each of its
+             * dependencies has a process fitting on some machine, according
+             * to the capacity lists.
+             *
+             * @param chunks Chunks after the capacity filter.
+             */
+            void
+            computeAllowedNeighborhoods ( const std::vector<Chunk>& chunks )
+            {
+                const uint numServices      = _model.getNumServices();
+                const uint numNeighborhoods = _model.getNumNeighborhoods();
+
+                std::vector<char> hostable ( numServices*numNeighborhoods, 0 );
+
+                for ( uint t = 0 ; t < chunks.size() ; ++t )
+                {
+                    const Chunk& chunk = chunks [ t ];
+                    uint         i     = 0;
+
+                    for ( uint p = chunk.first ; p < chunk.last ; ++p )
+                    {
+                        const uint service = _model.getService ( p );
+
+                        for ( uint c = 0 ; c < chunk.count [ p - chunk.first ] ; ++c, ++i )
+                        {
+                            hostable [ service*numNeighborhoods +
+                                       _model.getNeighborhood ( chunk.machines [ i ] ) ] = 1;
+                        }
+                    }
+                }
+
+                _allowed.assign ( numServices*numNeighborhoods, 1 );
+
+                for ( uint s = 0 ; s < numServices ; ++s )
+                {
+                    const ValuesView dependencies = _services.getDependencies ( s );
+
+                    for ( uint d = 0 ; d < dependencies.size() ; ++d )
+                    {
+                        for ( uint n = 0 ; n < numNeighborhoods ; ++n )
+                        {
+                            _allowed [ s*numNeighborhoods + n ]
+                                &= hostable [ dependencies [ d ]*numNeighborhoods + n ];
+                        }
+                    }
+                }
+            }
+
+            /**
+             * Dependency filter: drops, in place, the machines whose
+             * neighborhood isn't allowed for the process' service.
+             * O(candidates) per process.
+             *
+             * @param chunk Chunk after the capacity filter.
+             */
+            void
+            filterDependencies ( Chunk& chunk ) const
+            {
+                const uint numNeighborhoods = _model.getNumNeighborhoods();
+
+                uint read  = 0;
+                uint write = 0;
+
+                for ( uint p = chunk.first ; p < chunk.last ; ++p )
+                {
+                    const char* allowed
+                        = &_allowed [ _model.getService ( p )*numNeighborhoods ];
+
+                    uint& count = chunk.count [ p - chunk.first ];
+                    uint  kept  = 0;
+
+                    for ( uint c = 0 ; c < count ; ++c, ++read )
+                    {
+                        const ushort machine = chunk.machines [ read ];
+
+                        if ( allowed [ _model.getNeighborhood ( machine ) ] )
+                        {
+                            chunk.machines [ write++ ] = machine;
+                            ++kept;
+                        }
+                    }
+
+                    count = kept;
+                }
+
+                chunk.machines.resize ( write );
+            }
+
+        private:
+
+            const CompiledModel&    _model;
+            const Services&         _services;
+
+            /** Neighborhoods allowed per service, [S][N]. */
+            std::vector<char>       _allowed;
+            /** Candidates of process p: [_offset[p], _offset[p+1]). */
+            std::vector<ushort>     _machines;
+            std::vector<uint>       _offset;
+            /** Time the construction took. */
+            uint                    _milliseconds;
+    };
+};
+
+#endif
@@ -0,0 +1,355 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_COMPILED_MODEL_HPP
+#define __roadef12_COMPILED_MODEL_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/model/Resources.hpp"
+#include "roadef12-common/objects/model/Machines.hpp"
+#include "roadef12-common/objects/model/Services.hpp"
+#include "roadef12-common/objects/model/Processes.hpp"
+#include "roadef12-common/objects/model/GeneralCosts.hpp"
+#include "roadef12-common/util/AlignedAllocator.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Structure-of-arrays copy of the model for hot loops. Every array
+     * is 64-byte aligned, and per-resource rows (requirements, capacities)
+     * are padded with zeros up to getResourceStride() integers so that
+     * each row starts on its own cache line. Built once by Parameters;
+     * the per-section accessors keep working as before.
+     *
+     * @author daniperez
+     */
+    class CompiledModel
+    {
+        public:
+
+            /**
+             * Constructor.
+             */
+            CompiledModel ( const Resources& resources,
+                            const Machines& machines,
+                            const Services& services,
+                            const Processes& processes,
+                            const GeneralCosts& costs )
+                : _numResources ( resources.size() ),
+                  _numMachines ( machines.size() ),
+                  _numServices ( services.size() ),
+                  _numProcesses ( processes.size() ),
+                  _numBalances ( costs.getNumObjectiveBalance() ),
+                  _resourceStride ( pad ( _numResources ) ),
+                  _numLocations ( 0 ),
+                  _numNeighborhoods ( 0 )
+            {
+                compileResources ( resources );
+                compileMachines ( machines );
+                compileProcesses ( processes );
+                compileCosts ( costs );
+            }
+
+        public:
+
+            /**
+             * @name Sizes
+             */
+            ///@{
+            /** @return Number of resources. */
+            uint getNumResources () const { return _numResources; }
+            /** @return Number of machines. */
+            uint getNumMachines () const { return _numMachines; }
+            /** @return Number of services. */
+            uint getNumServices () const { return _numServices; }
+            /** @return Number of processes. */
+            uint getNumProcesses () const { return _numProcesses; }
+            /** @return Number of balance costs. */
+            uint getNumBalances () const { return _numBalances; }
+            /** @return Number of locations (highest id + 1). */
+            uint getNumLocations () const { return _numLocations; }
+            /** @return Number of neighborhoods (highest id + 1). */
+            uint getNumNeighborhoods () const { return _numNeighborhoods; }
+            /**
+             * @return Distance, in integers, between two consecutive
+             *         per-resource rows (multiple of 16).
+             */
+            uint getResourceStride () const { return _resourceStride; }
+            ///@}
+
+            /**
+             * @name Per-resource rows (getResourceStride() integers each)
+             */
+            ///@{
+            /**
+             * Requirements of a process.
+             *
+             * @param processId Process' id.
+             * @return Row of requirements, indexed by resource.
+             */
+            const int*
+            getRequirements ( uint processId ) const
+            {
+                return &_requirements [ processId*_resourceStride ];
+            }
+
+            /**
+             * Capacities of a machine.
+             *
+             * @param machineId Machine's id.
+             * @return Row of capacities, indexed by resource.
+             */
+            const int*
+            getCapacities ( uint machineId ) const
+            {
+                return &_capacities [ machineId*_resourceStride ];
+            }
+
+            /**
+             * Safety capacities of a machine.
+             *
+             * @param machineId Machine's id.
+             * @return Row of safety capacities, indexed by resource.
+             */
+            const int*
+            getSafetyCapacities ( uint machineId ) const
+            {
+                return &_safetyCapacities [ machineId*_resourceStride ];
+            }
+
+            /**
+             * Transient flags (1 if transient, 0 otherwise).
+             *
+             * @return Row of flags, indexed by resource.
+             */
+            const int*
+            getTransientFlags () const
+            {
+                return &_transient[0];
+            }
+
+            /**
+             * Load cost weights.
+             *
+             * @return Row of weights, indexed by resource.
+             */
+            const int*
+            getLoadCostWeights () const
+            {
+                return &_loadCostWeights[0];
+            }
+            ///@}
+
+            /**
+             * @name Scalars per process and machine
+             */
+            ///@{
+            /** @return Service of the process. */
+            int getService ( uint processId ) const
+            { return _processService [ processId ]; }
+            /** @return Process move cost of the process. */
+            int getPMC ( uint processId ) const
+            { return _processMoveCost [ processId ]; }
+            /** @return Location of the machine. */
+            int getLocation ( uint machineId ) const
+            { return _machineLocation [ machineId ]; }
+            /** @return Neighborhood of the machine. */
+            int getNeighborhood ( uint machineId ) const
+            { return _machineNeighborhood [ machineId ]; }
+            ///@}
+
+            /**
+             * @name Balance costs and weights
+             */
+            ///@{
+            /** @return First resource of the balance. */
+            int getBalanceR1 ( uint balanceId ) const
+            { return _balanceR1 [ balanceId ]; }
+            /** @return Second resource of the balance. */
+            int getBalanceR2 ( uint balanceId ) const
+            { return _balanceR2 [ balanceId ]; }
+            /** @return Target of the balance. */
+            int getBalanceTarget ( uint balanceId ) const
+            { return _balanceTarget [ balanceId ]; }
+            /** @return Weight of the balance. */
+            int getBalanceWeight ( uint balanceId ) const
+            { return _balanceWeight [ balanceId ]; }
+            /** @return Process move cost weight. */
+            int getProcessMoveCostWeight () const
+            { return _processMoveCostWeight; }
+            /** @return Service move cost weight. */
+            int getServiceMoveCostWeight () const
+            { return _serviceMoveCostWeight; }
+            /** @return Machine move cost weight. */
+            int getMachineMoveCostWeight () const
+            { return _machineMoveCostWeight; }
+            ///@}
+
+        protected:
+
+            /**
+             * Rounds n up to a whole number of cache lines of integers.
+             *
+             * @param n Number of integers.
+             * @return Padded size (at least 16).
+             */
+            static uint
+            pad ( uint n )
+            {
+                const uint perLine = 64 / sizeof ( int );
+
+                return std::max ( perLine, ( n + perLine - 1 ) / perLine * perLine );
+            }
+
+            /**
+             * Copies the resource flags and weights.
+             */
+            void
+            compileResources ( const Resources& resources )
+            {
+                _transient.assign ( _resourceStride, 0 );
+                _loadCostWeights.assign ( _resourceStride, 0 );
+
+                for ( uint r = 0 ; r < _numResources ; ++r )
+                {
+                    _transient [ r ]       = resources.isTransient ( r ) ? 1 : 0;
+                    _loadCostWeights [ r ] = resources.getLoadCostWeight ( r );
+                }
+            }
+
+            /**
+             * Copies capacities, locations and neighborhoods.
+             */
+            void
+            compileMachines ( const Machines& machines )
+            {
+                _capacities.assign ( _numMachines*_resourceStride, 0 );
+                _safetyCapacities.assign ( _numMachines*_resourceStride, 0 );
+                _machineLocation.resize ( _numMachines );
+                _machineNeighborhood.resize ( _numMachines );
+
+                for ( uint m = 0 ; m < _numMachines ; ++m )
+                {
+                    for ( uint r = 0 ; r < _numResources ; ++r )
+                    {
+                        _capacities [ m*_resourceStride + r ]
+                            = machines.getCapacity ( m, r );
+                        _safetyCapacities [ m*_resourceStride + r ]
+                            = machines.getSafetyCapacity ( m, r );
+                    }
+
+                    _machineLocation [ m ]     = machines.getLocation ( m );
+                    _machineNeighborhood [ m ] = machines.getNeighborhood ( m );
+
+                    _numLocations = std::max ( _numLocations,
+                                               uint ( _machineLocation [ m ] + 1 ) );
+                    _numNeighborhoods
+                        = std::max ( _numNeighborhoods,
+                                     uint ( _machineNeighborhood [ m ] + 1 ) );
+                }
+            }
+
+            /**
+             * Copies requirements, services and process move costs.
+             */
+            void
+            compileProcesses ( const Processes& processes )
+            {
+                _requirements.assign ( _numProcesses*_resourceStride, 0 );
+                _processService.resize ( _numProcesses );
+                _processMoveCost.resize ( _numProcesses );
+
+                for ( uint p = 0 ; p < _numProcesses ; ++p )
+                {
+                    for ( uint r = 0 ; r < _numResources ; ++r )
+                    {
+                        _requirements [ p*_resourceStride + r ]
+                            = processes.getRequirement ( p, r );
+                    }
+
+                    _processService [ p ]  = processes.getService ( p );
+                    _processMoveCost [ p ] = processes.getPMC ( p );
+                }
+            }
+
+            /**
+             * Copies balance costs and move cost weights.
+             */
+            void
+            compileCosts ( const GeneralCosts& costs )
+            {
+                _balanceR1.resize ( _numBalances );
+                _balanceR2.resize ( _numBalances );
+                _balanceTarget.resize ( _numBalances );
+                _balanceWeight.resize ( _numBalances );
+
+                for ( uint b = 0 ; b < _numBalances ; ++b )
+                {
+                    _balanceR1 [ b ]     = costs.getObjectiveBalanceR1 ( b );
+                    _balanceR2 [ b ]     = costs.getObjectiveBalanceR2 ( b );
+                    _balanceTarget [ b ] = costs.getObjectiveBalanceTarget ( b );
+                    _balanceWeight [ b ] = costs.getBalanceCostWeight ( b );
+                }
+
+                _processMoveCostWeight = costs.getProcessMoveCostWeight();
+                _serviceMoveCostWeight = costs.getServiceMoveCostWeight();
+                _machineMoveCostWeight = costs.getMachineMoveCostWeight();
+            }
+
+        private:
+
+            uint              _numResources;
+            uint              _numMachines;
+            uint              _numServices;
+            uint              _numProcesses;
+            uint              _numBalances;
+            uint              _resourceStride;
+            uint              _numLocations;
+            uint              _numNeighborhoods;
+
+            AlignedIntVector  _requirements;
+            AlignedIntVector  _capacities;
+            AlignedIntVector  _safetyCapacities;
+            AlignedIntVector  _transient;
+            AlignedIntVector  _loadCostWeights;
+
+            AlignedIntVector  _processService;
+            AlignedIntVector  _processMoveCost;
+            AlignedIntVector  _machineLocation;
+            AlignedIntVector  _machineNeighborhood;
+
+            AlignedIntVector  _balanceR1;
+            AlignedIntVector  _balanceR2;
+            AlignedIntVector  _balanceTarget;
+            AlignedIntVector  _balanceWeight;
+
+            int               _processMoveCostWeight;
+            int               _serviceMoveCostWeight;
+            int               _machineMoveCostWeight;
+    };
+};
+
+#endif
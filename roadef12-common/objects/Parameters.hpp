@@ -29,6 +29,8 @@
 #include "roadef12-common/objects/model/Services.hpp"
 #include "roadef12-common/objects/model/Processes.hpp"
 #include "roadef12-common/objects/model/GeneralCosts.hpp"
+#include "roadef12-common/objects/CompiledModel.hpp"
+#include "roadef12-common/util/ValuesView.hpp"
 ///////////////////////////////////////////////////////////////////////////
 // STD
 #include <vector>
@@ -49,14 +51,23 @@ namespace ROADEF12COMMON
         public:
             
             /**
-             * Constructor.
+             * Constructor. The viewed integers (a parsed vector or a
+             * mapped compiled instance) must outlive the parameters.
+             *
+             * @param parameters Model as per ROADEF's format, or without
+             *        the move costs if they are given apart.
+             * @param moveCosts Machine move costs already encoded (see
+             *        CompiledInstance), or none.
              */
-            Parameters ( const std::vector<int>& parameters )
+            Parameters ( const ValuesView& parameters,
+                         const boost::shared_ptr<const MoveCostMatrix>& moveCosts
+                             = boost::shared_ptr<const MoveCostMatrix>() )
                 : resources ( parameters ),
-                  machines  ( resources, parameters ),
+                  machines  ( resources, parameters, moveCosts ),
                   services  ( machines, parameters ),
                   processes ( resources, services, parameters ),
-                  costs     ( processes, resources, parameters )
+                  costs     ( processes, resources, parameters ),
+                  compiled  ( resources, machines, services, processes, costs )
             {
             }
             
@@ -86,6 +97,11 @@ namespace ROADEF12COMMON
              * Costs.
              */
             const GeneralCosts costs;
+
+            /**
+             * Structure-of-arrays view of the above for hot loops.
+             */
+            const CompiledModel compiled;
     };
 
 };
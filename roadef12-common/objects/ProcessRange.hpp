@@ -0,0 +1,118 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_PROCESS_RANGE_HPP
+#define __roadef12_PROCESS_RANGE_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <cstddef>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Read-only view over a contiguous run of process ids, as returned
+     * by Assignment's indexes. Iterating doesn't allocate. The view is
+     * invalidated by any change to the assignment it comes from.
+     *
+     * @author daniperez
+     */
+    class ProcessRange
+    {
+        public:
+
+            /**
+             * Iterator types (BOOST_FOREACH needs both).
+             */
+            typedef const ushort* const_iterator;
+            typedef const ushort* iterator;
+
+            /**
+             * Constructor. Views a raw array.
+             *
+             * @param data First process id.
+             * @param size Number of process ids.
+             */
+            ProcessRange ( const ushort* data, size_t size )
+                : _data ( data ), _size ( size )
+            {
+            }
+
+            /**
+             * Returns the i-th process id.
+             *
+             * @param i Index.
+             * @return Process id.
+             */
+            ushort
+            operator[] ( size_t i ) const
+            {
+                return _data [ i ];
+            }
+
+            /**
+             * Number of processes.
+             *
+             * @return Size of the view.
+             */
+            size_t
+            size () const
+            {
+                return _size;
+            }
+
+            /**
+             * @return True if there are no processes.
+             */
+            bool
+            empty () const
+            {
+                return _size == 0;
+            }
+
+            /**
+             * @return Iterator to the first process id.
+             */
+            const_iterator
+            begin () const
+            {
+                return _data;
+            }
+
+            /**
+             * @return Past-the-end iterator.
+             */
+            const_iterator
+            end () const
+            {
+                return _data + _size;
+            }
+
+        private:
+
+            const ushort* _data;
+            size_t        _size;
+    };
+};
+
+#endif
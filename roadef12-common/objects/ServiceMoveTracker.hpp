@@ -0,0 +1,178 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_SERVICE_MOVE_TRACKER_HPP
+#define __roadef12_SERVICE_MOVE_TRACKER_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Number of moved processes per service and its maximum (the service
+     * move cost, before weighting). Besides the count of each service it
+     * keeps how many services have each count, so both updates and
+     * "what would the maximum be" queries are O(1) instead of a scan over
+     * the services.
+     *
+     * @author daniperez
+     */
+    class ServiceMoveTracker
+    {
+        public:
+
+            /**
+             * Constructor. No process is moved.
+             *
+             * @param numServices Number of services.
+             * @param numProcesses Number of processes (highest count).
+             */
+            ServiceMoveTracker ( uint numServices, uint numProcesses )
+                : _moved ( numServices, 0 ),
+                  _services ( numProcesses + 1, 0 ),
+                  _max ( 0 )
+            {
+                _services [ 0 ] = numServices;
+            }
+
+            /**
+             * Forgets all the moves.
+             */
+            void
+            clear ()
+            {
+                std::fill ( _moved.begin(), _moved.end(), 0 );
+                std::fill ( _services.begin(), _services.end(), 0 );
+                _services [ 0 ] = _moved.size();
+                _max = 0;
+            }
+
+            /**
+             * Adds one moved process (moved=1) to the service or removes
+             * one (moved=-1). O(1).
+             *
+             * @param service Service.
+             * @param moved 1 or -1.
+             */
+            void
+            update ( uint service, int moved )
+            {
+                uint& count = _moved [ service ];
+
+                --_services [ count ];
+                count += moved;
+                ++_services [ count ];
+
+                if ( count > _max )
+                {
+                    _max = count;
+                }
+                else if ( _services [ _max ] == 0 )
+                {
+                    // Counts change by one, so the maximum does too
+                    --_max;
+                }
+            }
+
+            /**
+             * Number of moved processes of the service.
+             *
+             * @param service Service.
+             * @return Count.
+             */
+            uint
+            get ( uint service ) const
+            {
+                return _moved [ service ];
+            }
+
+            /**
+             * Highest number of moved processes over all the services.
+             *
+             * @return Maximum count.
+             */
+            uint
+            getMax () const
+            {
+                return _max;
+            }
+
+            /**
+             * Maximum there would be if the count of service1 changed by
+             * moved1 and the one of service2 by moved2, each in [-1, 1]
+             * (both services may be the same). O(1): the services left
+             * alone can only hold the maximum or, when the changed ones
+             * held it, one of the two counts below it.
+             *
+             * @param service1 Service.
+             * @param moved1 Change of its count.
+             * @param service2 Service.
+             * @param moved2 Change of its count.
+             * @return New maximum.
+             */
+            uint
+            getMaxAfter ( uint service1, int moved1,
+                          uint service2, int moved2 ) const
+            {
+                const bool same   = ( service1 == service2 );
+                const uint count1 = _moved [ service1 ];
+                const uint count2 = _moved [ service2 ];
+
+                uint newMax = 0;
+
+                for ( int v = _max ; v >= int ( _max ) - 2 && v >= 0 ; --v )
+                {
+                    const uint others = _services [ v ] -
+                                        ( count1 == uint ( v ) ) -
+                                        ( ! same && count2 == uint ( v ) );
+
+                    if ( others > 0 )
+                    {
+                        newMax = v;
+                        break;
+                    }
+                }
+
+                if ( same )
+                {
+                    return std::max ( newMax, count1 + moved1 + moved2 );
+                }
+
+                return std::max ( newMax,
+                                  std::max ( count1 + moved1, count2 + moved2 ) );
+            }
+
+        private:
+
+            /** Moved processes per service. */
+            std::vector<uint> _moved;
+            /** Number of services per count of moved processes. */
+            std::vector<uint> _services;
+            /** Highest count. */
+            uint              _max;
+    };
+};
+
+#endif
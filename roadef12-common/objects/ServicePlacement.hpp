@@ -0,0 +1,151 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_SERVICE_PLACEMENT_HPP
+#define __roadef12_SERVICE_PLACEMENT_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Where the processes of each service are: dense counters per
+     * (service, location) and per (service, neighborhood), plus the number
+     * of locations used by each service. Adding or removing a process is
+     * O(1), so spread and dependency constraints can be checked exactly
+     * at any point of a search.
+     *
+     * @author daniperez
+     */
+    class ServicePlacement
+    {
+        public:
+
+            /**
+             * Constructor. No process is placed.
+             *
+             * @param numServices Number of services.
+             * @param numLocations Number of locations.
+             * @param numNeighborhoods Number of neighborhoods.
+             */
+            ServicePlacement ( uint numServices,
+                               uint numLocations,
+                               uint numNeighborhoods )
+                : _numLocations ( numLocations ),
+                  _numNeighborhoods ( numNeighborhoods ),
+                  _locationsUsed ( numServices, 0 ),
+                  _perLocation ( numServices*numLocations, 0 ),
+                  _perNeighborhood ( numServices*numNeighborhoods, 0 )
+            {
+            }
+
+            /**
+             * Removes all the processes.
+             */
+            void
+            clear ()
+            {
+                std::fill ( _locationsUsed.begin(), _locationsUsed.end(), 0 );
+                std::fill ( _perLocation.begin(), _perLocation.end(), 0 );
+                std::fill ( _perNeighborhood.begin(), _perNeighborhood.end(), 0 );
+            }
+
+            /**
+             * Places a process of the service. O(1).
+             *
+             * @param service Service.
+             * @param location Location of the process' machine.
+             * @param neighborhood Neighborhood of the process' machine.
+             */
+            void
+            add ( uint service, uint location, uint neighborhood )
+            {
+                if ( _perLocation [ service*_numLocations + location ]++ == 0 )
+                {
+                    ++_locationsUsed [ service ];
+                }
+
+                ++_perNeighborhood [ service*_numNeighborhoods + neighborhood ];
+            }
+
+            /**
+             * Removes a process of the service. O(1).
+             *
+             * @param service Service.
+             * @param location Location of the process' machine.
+             * @param neighborhood Neighborhood of the process' machine.
+             */
+            void
+            remove ( uint service, uint location, uint neighborhood )
+            {
+                if ( --_perLocation [ service*_numLocations + location ] == 0 )
+                {
+                    --_locationsUsed [ service ];
+                }
+
+                --_perNeighborhood [ service*_numNeighborhoods + neighborhood ];
+            }
+
+            /**
+             * @return Number of locations with processes of the service.
+             */
+            uint
+            getNumLocations ( uint service ) const
+            {
+                return _locationsUsed [ service ];
+            }
+
+            /**
+             * @return Number of processes of the service in the location.
+             */
+            uint
+            getInLocation ( uint service, uint location ) const
+            {
+                return _perLocation [ service*_numLocations + location ];
+            }
+
+            /**
+             * @return Number of processes of the service in the neighborhood.
+             */
+            uint
+            getInNeighborhood ( uint service, uint neighborhood ) const
+            {
+                return _perNeighborhood [ service*_numNeighborhoods + neighborhood ];
+            }
+
+        private:
+
+            uint                _numLocations;
+            uint                _numNeighborhoods;
+            /** Locations used per service, [S]. */
+            std::vector<ushort> _locationsUsed;
+            /** Processes per (service, location), [S][L]. */
+            std::vector<ushort> _perLocation;
+            /** Processes per (service, neighborhood), [S][N]. */
+            std::vector<ushort> _perNeighborhood;
+    };
+};
+
+#endif
@@ -0,0 +1,295 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_SLACK_INDEX_HPP
+#define __roadef12_SLACK_INDEX_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Remaining capacity (slack) of every machine and resource, indexed to
+     * answer "which machines can host these requirements" without
+     * scanning the M machines. Per resource, machines are linked into
+     * power-of-two buckets of slack: bucket 0 holds slack <= 0, bucket b
+     * holds [2^(b-1), 2^b). A query walks the buckets of the resource with
+     * the fewest machines above the requirement and checks the other
+     * resources of each machine visited. Updating a machine is O(R) and
+     * doesn't allocate.
+     *
+     * @author daniperez
+     */
+    class SlackIndex
+    {
+        public:
+
+            /**
+             * Constructor. Every machine has no slack.
+             *
+             * @param numMachines Number of machines.
+             * @param numResources Number of resources.
+             */
+            SlackIndex ( uint numMachines, uint numResources )
+                : _numMachines ( numMachines ),
+                  _numResources ( numResources ),
+                  _slack ( numMachines*numResources, 0 ),
+                  _bucket ( numMachines*numResources, 0 ),
+                  _next ( numMachines*numResources, NONE ),
+                  _previous ( numMachines*numResources, NONE ),
+                  _head ( numResources*NUM_BUCKETS, NONE ),
+                  _count ( numResources*NUM_BUCKETS, 0 )
+            {
+                for ( uint r = 0 ; r < _numResources ; ++r )
+                {
+                    for ( uint m = 0 ; m < _numMachines ; ++m )
+                    {
+                        link ( r, m, 0 );
+                    }
+                }
+            }
+
+        public:
+
+            /**
+             * Sets the slack of a machine to capacity - load - kept, per
+             * resource. O(R).
+             *
+             * @param machine Machine.
+             * @param capacities Row of R capacities.
+             * @param load Row of R loads.
+             * @param kept Row of R transient usages kept on the machine.
+             */
+            void
+            update ( uint machine,
+                     const int* capacities,
+                     const uint* load,
+                     const uint* kept )
+            {
+                int* slack = &_slack [ machine*_numResources ];
+
+                for ( uint r = 0 ; r < _numResources ; ++r )
+                {
+                    slack [ r ] = capacities [ r ] - int ( load [ r ] ) -
+                                  int ( kept [ r ] );
+
+                    const uint bucket = getBucket ( slack [ r ] );
+
+                    if ( bucket != _bucket [ machine*_numResources + r ] )
+                    {
+                        unlink ( r, machine );
+                        link ( r, machine, bucket );
+                    }
+                }
+            }
+
+            /**
+             * Returns the slack of a machine. O(1).
+             *
+             * @param machine Machine.
+             * @return Row of R slacks.
+             */
+            const int*
+            getSlacks ( uint machine ) const
+            {
+                return &_slack [ machine*_numResources ];
+            }
+
+            /**
+             * Says if the requirements fit in the machine's slack. O(R).
+             *
+             * @param machine Machine.
+             * @param requirements Row of R requirements.
+             * @return True if they fit on every resource.
+             */
+            bool
+            fits ( uint machine, const int* requirements ) const
+            {
+                const int* slack = &_slack [ machine*_numResources ];
+
+                for ( uint r = 0 ; r < _numResources ; ++r )
+                {
+                    if ( slack [ r ] < requirements [ r ] )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Finds the machines where the requirements fit. O(R*buckets)
+             * plus O(R) per machine having enough slack on the most
+             * selective resource.
+             *
+             * @param requirements Row of R requirements.
+             * @param output Array of M machine ids to fill in.
+             * @return Number of machines written, in no particular order.
+             */
+            uint
+            findFits ( const int* requirements, ushort* output ) const
+            {
+                // The most selective resource drives the walk
+                uint driver = 0;
+                uint fewest = _numMachines + 1;
+
+                for ( uint r = 0 ; r < _numResources ; ++r )
+                {
+                    const uint* count = &_count [ r*NUM_BUCKETS ];
+                    uint        above = 0;
+
+                    for ( uint b = getBucket ( requirements [ r ] ) ;
+                          b < NUM_BUCKETS ;
+                          ++b )
+                    {
+                        above += count [ b ];
+                    }
+
+                    if ( above < fewest )
+                    {
+                        fewest = above;
+                        driver = r;
+                    }
+                }
+
+                uint found = 0;
+
+                for ( uint b = getBucket ( requirements [ driver ] ) ;
+                      b < NUM_BUCKETS ;
+                      ++b )
+                {
+                    for ( int m = _head [ driver*NUM_BUCKETS + b ] ;
+                          m != NONE ;
+                          m = _next [ m*_numResources + driver ] )
+                    {
+                        if ( fits ( m, requirements ) )
+                        {
+                            output [ found++ ] = m;
+                        }
+                    }
+                }
+
+                return found;
+            }
+
+        protected:
+
+            /**
+             * Bucket of a slack: 0 if not positive, 1 + floor(log2(slack))
+             * otherwise.
+             *
+             * @param slack Slack.
+             * @return Bucket in [0, NUM_BUCKETS).
+             */
+            static uint
+            getBucket ( int slack )
+            {
+                return slack <= 0 ? 0 : 32 - __builtin_clz ( uint ( slack ) );
+            }
+
+            /**
+             * Pushes the machine in front of the bucket's list of the
+             * resource.
+             */
+            void
+            link ( uint resource, uint machine, uint bucket )
+            {
+                const uint node = machine*_numResources + resource;
+                int&       head = _head [ resource*NUM_BUCKETS + bucket ];
+
+                _bucket [ node ]   = bucket;
+                _previous [ node ] = NONE;
+                _next [ node ]     = head;
+
+                if ( head != NONE )
+                {
+                    _previous [ head*_numResources + resource ] = machine;
+                }
+
+                head = machine;
+                ++_count [ resource*NUM_BUCKETS + bucket ];
+            }
+
+            /**
+             * Removes the machine from its bucket's list of the resource.
+             */
+            void
+            unlink ( uint resource, uint machine )
+            {
+                const uint node     = machine*_numResources + resource;
+                const uint bucket   = _bucket [ node ];
+                const int  next     = _next [ node ];
+                const int  previous = _previous [ node ];
+
+                if ( previous != NONE )
+                {
+                    _next [ previous*_numResources + resource ] = next;
+                }
+                else
+                {
+                    _head [ resource*NUM_BUCKETS + bucket ] = next;
+                }
+
+                if ( next != NONE )
+                {
+                    _previous [ next*_numResources + resource ] = previous;
+                }
+
+                --_count [ resource*NUM_BUCKETS + bucket ];
+            }
+
+        protected:
+
+            /**
+             * Buckets per resource (slack <= 0, then one per power of 2)
+             * and end of a list.
+             */
+            enum
+            {
+                NUM_BUCKETS = 33,
+                NONE        = -1
+            };
+
+        private:
+
+            uint                _numMachines;
+            uint                _numResources;
+            /** Slack, [M][R]. */
+            std::vector<int>    _slack;
+            /** Bucket of each (machine, resource), [M][R]. */
+            std::vector<uint>   _bucket;
+            /** Doubly-linked lists of machines per (resource, bucket), [M][R]. */
+            std::vector<int>    _next;
+            std::vector<int>    _previous;
+            /** First machine per (resource, bucket), [R][NUM_BUCKETS]. */
+            std::vector<int>    _head;
+            /** Machines per (resource, bucket), [R][NUM_BUCKETS]. */
+            std::vector<uint>   _count;
+    };
+};
+
+#endif
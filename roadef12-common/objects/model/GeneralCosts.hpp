@@ -52,10 +52,15 @@ namespace ROADEF12COMMON
             GeneralCosts (
                         const Processes& processes,
                         const Resources& resources,
-                        const std::vector<int>& values )
+                        const ValuesView& values )
                 : _processes ( processes ),
                   _resources ( resources ),
-                  _values (values)
+                  _values (values),
+                  _startIndex ( processes.startIndex() + 1 +
+                                processes.size()*processes.getDefinitionSize() ),
+                  _numObjectiveBalance ( _values [ _startIndex ] ),
+                  _weightsIndex ( _startIndex + 1 +
+                                  getBalanceDefinitionSize()*_numObjectiveBalance )
             {
             }
 
@@ -131,7 +136,7 @@ namespace ROADEF12COMMON
             uint
             getNumObjectiveBalance() const
             {
-                return _values [ startIndex() ];
+                return _numObjectiveBalance;
             }
             
             /**
@@ -235,9 +240,7 @@ namespace ROADEF12COMMON
             uint
             getProcessMoveCostWeight () const
             {
-                return _values [
-                    startIndex() + 1 +
-                    getBalanceDefinitionSize()*getNumObjectiveBalance() ] ;
+                return _values [ _weightsIndex ] ;
             }
             
             /**
@@ -249,9 +252,7 @@ namespace ROADEF12COMMON
             uint
             getServiceMoveCostWeight () const
             {
-                return _values [
-                    startIndex() + 1 +
-                    getBalanceDefinitionSize()*getNumObjectiveBalance() + 1 ] ;
+                return _values [ _weightsIndex + 1 ] ;
             }
                         
             /**
@@ -263,10 +264,7 @@ namespace ROADEF12COMMON
             uint
             getMachineMoveCostWeight () const
             {
-                return _values [
-                    startIndex() + 1 +
-                    getBalanceDefinitionSize()*getNumObjectiveBalance() +
-                    1 + 1 ] ;
+                return _values [ _weightsIndex + 1 + 1 ] ;
             }
                        
             /**
@@ -278,16 +276,8 @@ namespace ROADEF12COMMON
             int
             getLoadCostWeight ( uint resourceId ) const
             {
-                assert ( _resources.exists ( resourceId ) );
-
-                return
-                    _values
-                    [
-                      startIndex()+
-                      1+
-                      resourceId*_resources.getDefinitionSize()+
-                      1
-                    ]; 
+                // Load cost weights are defined along with the resources.
+                return _resources.getLoadCostWeight ( resourceId );
             }
             ///@}
             
@@ -299,15 +289,14 @@ namespace ROADEF12COMMON
             ///@{ 
             /**
              * According to ROADEF's format, where
-             * this item's definition start.
+             * this item's definition start. Computed once at construction.
              * 
              * @return Index of the start of definition.
              */ 
             uint
             startIndex () const
             {
-                return _processes.startIndex() + 1 +
-                       _processes.size()*_processes.getDefinitionSize();
+                return _startIndex;
             }
             
             /**
@@ -326,7 +315,10 @@ namespace ROADEF12COMMON
             
             const Processes&        _processes;
             const Resources&        _resources;
-            const std::vector<int>& _values;
+            const ValuesView        _values;
+            const uint              _startIndex;
+            const uint              _numObjectiveBalance;
+            const uint              _weightsIndex;
     };
 };
 
@@ -25,6 +25,7 @@
 ///////////////////////////////////////////////////////////////////////////
 // roadef12
 #include "roadef12-common/objects/model/Resources.hpp"
+#include "roadef12-common/objects/model/MoveCostMatrix.hpp"
 ///////////////////////////////////////////////////////////////////////////
 // STD
 #include <vector>
@@ -32,6 +33,7 @@
 ///////////////////////////////////////////////////////////////////////////
 // BOOST
 #include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
 ///////////////////////////////////////////////////////////////////////////
 
 namespace ROADEF12COMMON
@@ -46,11 +48,36 @@ namespace ROADEF12COMMON
         public:
             
             /**
-             * Constructor.
+             * Constructor. If no move cost matrix is given, the values
+             * follow ROADEF's format and the matrix is encoded from the
+             * costs in the machine definitions. Otherwise the definitions
+             * come without them (see CompiledInstance) and the given
+             * matrix is used.
+             *
+             * @param resources Resources.
+             * @param values Model.
+             * @param moveCosts Matrix already encoded, or none.
              */
             Machines
-              ( const Resources& resources, const std::vector<int>& values )
-                : _resources ( resources ), _values (values)
+              ( const Resources& resources,
+                const ValuesView& values,
+                const boost::shared_ptr<const MoveCostMatrix>& moveCosts
+                    = boost::shared_ptr<const MoveCostMatrix>() )
+                : _resources ( resources ), _values (values),
+                  _numResources ( resources.size() ),
+                  _startIndex ( 1 + resources.size()*resources.getDefinitionSize() ),
+                  _size ( _values [ _startIndex ] ),
+                  _definitionSize ( 1 + 1 + _numResources + _numResources +
+                                    ( moveCosts ? 0 : _size ) ),
+                  _moveCosts ( moveCosts ? moveCosts :
+                               boost::shared_ptr<const MoveCostMatrix>
+                               (
+                                   new MoveCostMatrix ( _values,
+                                                        getCapacitiesIndex ( 0 ) +
+                                                            2*_numResources,
+                                                        _definitionSize,
+                                                        _size )
+                               ) )
             {
             }
             
@@ -62,7 +89,7 @@ namespace ROADEF12COMMON
             uint
             size () const
             {
-                return _values [ startIndex() ];
+                return _size;
             }
 
         public:
@@ -135,12 +162,13 @@ namespace ROADEF12COMMON
                 assert ( _resources.exists ( resourceId ) );
                 
                 return _values [ getCapacitiesIndex ( machineId ) +
-                                 _resources.size () +
+                                 _numResources +
                                  resourceId ]; 
             }
             
             /**
              * Returns the cost of moving machineId to moveToMachineId.
+             * Read from the compact matrix (see MoveCostMatrix).
              * 
              * @param machineId Machine's id.
              * @param moveToMachineId Destination machine's id.
@@ -152,10 +180,32 @@ namespace ROADEF12COMMON
                 assert ( exists ( machineId ) );
                 assert ( exists ( moveToMachineId ) );
                 
-                return _values [ getCapacitiesIndex ( machineId ) +
-                                 _resources.size () +
-                                 _resources.size() +
-                                 moveToMachineId ]; 
+                return _moveCosts->get ( machineId, moveToMachineId ); 
+            }
+
+            /**
+             * Returns the costs of moving machineId to every machine.
+             * 
+             * @param machineId Machine's id.
+             * @param output Array of size() integers to fill in.
+             */ 
+            void
+            getMovingCosts ( uint machineId, int* output ) const
+            {
+                assert ( exists ( machineId ) );
+
+                _moveCosts->getRow ( machineId, output );
+            }
+
+            /**
+             * Returns the compact moving cost matrix.
+             * 
+             * @return Matrix.
+             */ 
+            const MoveCostMatrix&
+            getMoveCostMatrix () const
+            {
+                return *_moveCosts;
             }
             ///@}
             
@@ -253,14 +303,14 @@ namespace ROADEF12COMMON
             ///@{ 
             /**
              * According to ROADEF's format, where
-             * this item's definition start.
+             * this item's definition start. Computed once at construction.
              * 
              * @return Index of the start of definition.
              */ 
             uint
             startIndex () const
             {
-                return 1 +  _resources.size()*_resources.getDefinitionSize();
+                return _startIndex;
             }
                           
             /**
@@ -271,8 +321,7 @@ namespace ROADEF12COMMON
             uint
             getDefinitionSize () const
             {
-                return 1 + 1 + _resources.size() + _resources.size() +
-                      size();
+                return _definitionSize;
             }
              
             /**
@@ -285,10 +334,10 @@ namespace ROADEF12COMMON
             getNeighborhoodIndex ( uint machineId ) const
             {
                 // We jump size
-                uint idx = startIndex() + 1;
+                uint idx = _startIndex + 1;
                 
                 // We jump the previous machines
-                idx += machineId*getDefinitionSize();
+                idx += machineId*_definitionSize;
                 
                 return idx;
             }
@@ -309,7 +358,12 @@ namespace ROADEF12COMMON
         private:
             
             const Resources&        _resources;
-            const std::vector<int>& _values;
+            const ValuesView        _values;
+            const uint              _numResources;
+            const uint              _startIndex;
+            const uint              _size;
+            const uint              _definitionSize;
+            const boost::shared_ptr<const MoveCostMatrix> _moveCosts;
     };
 };
 
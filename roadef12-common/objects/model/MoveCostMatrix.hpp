@@ -0,0 +1,302 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_MOVE_COST_MATRIX_HPP
+#define __roadef12_MOVE_COST_MATRIX_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/util/ValuesView.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Compact machine move cost matrix (MMC). Costs are stored in one
+     * byte each, or two bytes if too many of them don't fit in a byte.
+     * The highest code of the chosen width is an escape: the actual
+     * value is then looked up in a hash map. Lookup is O(1) either way.
+     *
+     * @author daniperez
+     */
+    class MoveCostMatrix
+    {
+        public:
+
+            /**
+             * Constructor. Encodes a size x size matrix stored in values
+             * with a distance of stride integers between rows.
+             *
+             * @param values Raw model.
+             * @param first Index of the first cost of the first row.
+             * @param stride Distance between two consecutive rows.
+             * @param size Number of machines.
+             */
+            MoveCostMatrix ( const ValuesView& values,
+                             uint first,
+                             uint stride,
+                             uint size )
+                : _size ( size ),
+                  _wide ( false ),
+                  _numEscapes ( 0 ),
+                  _narrowCodes ( size_t ( size ) * size )
+            {
+                for ( uint m = 0 ; m < size ; ++m )
+                {
+                    setRow ( m, &values [ first + m*stride ] );
+                }
+            }
+
+            /**
+             * Constructor. Empty matrix, to be filled in row by row (see
+             * setRow) as the model is parsed, so that the raw matrix
+             * never has to be held in memory.
+             *
+             * @param size Number of machines.
+             */
+            explicit MoveCostMatrix ( uint size )
+                : _size ( size ),
+                  _wide ( false ),
+                  _numEscapes ( 0 ),
+                  _narrowCodes ( size_t ( size ) * size )
+            {
+            }
+
+            /**
+             * Encodes a row. Codes start one byte wide and are widened
+             * to two bytes once escapes stop being rare (more than 1/64
+             * of the matrix).
+             *
+             * @param from Original machine.
+             * @param row The size() costs of moving from it.
+             */
+            void
+            setRow ( uint from, const int* row )
+            {
+                for ( uint n = 0 ; n < _size ; ++n )
+                {
+                    _numEscapes += ( row [ n ] < 0 || row [ n ] >= NARROW_ESCAPE ) ? 1 : 0;
+                }
+
+                if ( ! _wide && _numEscapes > ( uint64_t ( _size ) * _size ) / 64 )
+                {
+                    widen ();
+                }
+
+                for ( uint n = 0 ; n < _size ; ++n )
+                {
+                    set ( from, n, row [ n ] );
+                }
+            }
+
+            /**
+             * Cost of moving a process from a machine to another.
+             *
+             * @param from Original machine.
+             * @param to Destination machine.
+             * @return Move cost.
+             */
+            int
+            get ( uint from, uint to ) const
+            {
+                size_t index = size_t ( from ) * _size + to;
+                int result;
+
+                if ( _wide )
+                {
+                    uint code = _wideCodes [ index ];
+                    result = ( code == WIDE_ESCAPE ) ? escaped ( index ) : code;
+                }
+                else
+                {
+                    uint code = _narrowCodes [ index ];
+                    result = ( code == NARROW_ESCAPE ) ? escaped ( index ) : code;
+                }
+
+                return result;
+            }
+
+            /**
+             * Decodes a whole row, i.e. the costs of moving from the given
+             * machine to every machine.
+             *
+             * @param from Original machine.
+             * @param output Array of (at least) size() integers to fill in.
+             */
+            void
+            getRow ( uint from, int* output ) const
+            {
+                size_t first = size_t ( from ) * _size;
+
+                if ( _wide )
+                {
+                    decodeRow ( &_wideCodes [ first ], first, WIDE_ESCAPE, output );
+                }
+                else
+                {
+                    decodeRow ( &_narrowCodes [ first ], first, NARROW_ESCAPE, output );
+                }
+            }
+
+            /**
+             * Number of machines.
+             *
+             * @return Matrix side.
+             */
+            uint
+            size () const
+            {
+                return _size;
+            }
+
+            /**
+             * Bytes taken by the codes and the escaped values.
+             *
+             * @return Approximate memory footprint.
+             */
+            size_t
+            getMemoryUsage () const
+            {
+                return _narrowCodes.size() +
+                       _wideCodes.size() * sizeof ( uint16_t ) +
+                       _escapes.size() * ( sizeof ( size_t ) + sizeof ( int ) );
+            }
+
+        protected:
+
+            /**
+             * Escape codes.
+             */
+            enum
+            {
+                NARROW_ESCAPE = 0xFF,
+                WIDE_ESCAPE   = 0xFFFF
+            };
+
+            /**
+             * Stores a cost, escaping it if it doesn't fit.
+             */
+            void
+            set ( uint from, uint to, int cost )
+            {
+                size_t index = size_t ( from ) * _size + to;
+                int escape = _wide ? WIDE_ESCAPE : NARROW_ESCAPE;
+                int code = ( cost < 0 || cost >= escape ) ? escape : cost;
+
+                if ( code == escape )
+                {
+                    _escapes [ index ] = cost;
+                }
+
+                if ( _wide )
+                {
+                    _wideCodes [ index ] = code;
+                }
+                else
+                {
+                    _narrowCodes [ index ] = code;
+                }
+            }
+
+            /**
+             * Switches to two-byte codes. Narrow escapes that fit in two
+             * bytes leave the hash map.
+             */
+            void
+            widen ()
+            {
+                _wideCodes.assign ( _narrowCodes.begin(), _narrowCodes.end() );
+
+                std::vector<uint8_t>().swap ( _narrowCodes );
+
+                std::unordered_map<size_t, int> escapes;
+
+                for ( std::unordered_map<size_t, int>::const_iterator it = _escapes.begin() ;
+                      it != _escapes.end() ;
+                      ++it )
+                {
+                    if ( it->second < 0 || it->second >= WIDE_ESCAPE )
+                    {
+                        _wideCodes [ it->first ] = WIDE_ESCAPE;
+                        escapes.insert ( *it );
+                    }
+                    else
+                    {
+                        _wideCodes [ it->first ] = it->second;
+                    }
+                }
+
+                _escapes.swap ( escapes );
+                _wide = true;
+            }
+
+            /**
+             * Value of an escaped cost.
+             */
+            int
+            escaped ( size_t index ) const
+            {
+                return _escapes.find ( index )->second;
+            }
+
+            /**
+             * Decodes a row of codes of any width.
+             */
+            template <typename Code>
+            void
+            decodeRow ( const Code* codes, size_t first, uint escape,
+                        int* output ) const
+            {
+                for ( uint n = 0 ; n < _size ; ++n )
+                {
+                    output [ n ] = codes [ n ];
+                }
+
+                if ( ! _escapes.empty() )
+                {
+                    for ( uint n = 0 ; n < _size ; ++n )
+                    {
+                        if ( codes [ n ] == escape )
+                        {
+                            output [ n ] = escaped ( first + n );
+                        }
+                    }
+                }
+            }
+
+        private:
+
+            uint                            _size;
+            bool                            _wide;
+            /** Costs that don't fit in one byte, seen so far. */
+            uint64_t                        _numEscapes;
+            std::vector<uint8_t>            _narrowCodes;
+            std::vector<uint16_t>           _wideCodes;
+            std::unordered_map<size_t, int> _escapes;
+    };
+};
+
+#endif
@@ -52,10 +52,15 @@ namespace ROADEF12COMMON
              */
             Processes ( const Resources& resources,
                       const Services& services,
-                      const std::vector<int>& values )
+                      const ValuesView& values )
                 : _resources ( resources ),
                   _services ( services ),
-                  _values (values)
+                  _values (values),
+                  _startIndex ( services.startIndex() +
+                                services.getAllServicesDefinitionSize() ),
+                  _size ( _values [ _startIndex ] ),
+                  _definitionSize ( 1 + resources.size() + 1 ),
+                  _numResources ( resources.size() )
             {
             }
             
@@ -67,7 +72,7 @@ namespace ROADEF12COMMON
             uint
             size () const
             {
-                return _values [ startIndex() ];
+                return _size;
             }
 
         public:
@@ -98,7 +103,7 @@ namespace ROADEF12COMMON
             getPMC ( uint processId ) const
             {
                 return _values [ getResourcesStartIndex( processId ) +
-                                 _resources.size() ]; 
+                                 _numResources ]; 
             }
 
             /**
@@ -194,15 +199,14 @@ namespace ROADEF12COMMON
             ///@{ 
             /**
              * According to ROADEF's format, where
-             * this item's definition start.
+             * this item's definition start. Computed once at construction.
              * 
              * @return Index of the start of definition.
              */ 
             uint
             startIndex () const
             {
-                return _services.startIndex() +
-                       _services.getAllServicesDefinitionSize();
+                return _startIndex;
             }
                           
             /**
@@ -213,7 +217,7 @@ namespace ROADEF12COMMON
             uint
             getDefinitionSize () const
             {
-                return 1 + _resources.size() + 1;
+                return _definitionSize;
             }
 
             /**
@@ -226,7 +230,7 @@ namespace ROADEF12COMMON
             uint
             getServiceStartIndex ( uint processId ) const
             {
-                return startIndex() + 1 + processId*getDefinitionSize();
+                return _startIndex + 1 + processId*_definitionSize;
             }
             
             /**
@@ -247,7 +251,11 @@ namespace ROADEF12COMMON
             
             const Resources&        _resources;
             const Services&         _services;
-            const std::vector<int>& _values;
+            const ValuesView        _values;
+            const uint              _startIndex;
+            const uint              _size;
+            const uint              _definitionSize;
+            const uint              _numResources;
     };
 };
 
@@ -24,6 +24,7 @@
 #define __roadef12_RESOURCES_HPP
 ///////////////////////////////////////////////////////////////////////////
 // roadef12
+#include "roadef12-common/util/ValuesView.hpp"
 ///////////////////////////////////////////////////////////////////////////
 // STD
 #include <vector>
@@ -49,8 +50,9 @@ namespace ROADEF12COMMON
             /**
              * Constructor.
              */
-            Resources ( const std::vector<int>& values )
-                : _values(values)
+            Resources ( const ValuesView& values )
+                : _values(values),
+                  _size ( _values [ startIndex() ] )
             {
             }
             
@@ -62,7 +64,7 @@ namespace ROADEF12COMMON
             uint
             size () const
             {
-                return _values [ startIndex() ];
+                return _size;
             }
 
         public:
@@ -85,6 +87,20 @@ namespace ROADEF12COMMON
                 
                 return _values[ startIndex() + 1 + resourceId*getDefinitionSize() ];
             }
+
+            /**
+             * Weight of the resource's load cost.
+             *
+             * @param resourceId Resource's id.
+             * @return Resource's load cost weight.
+             */
+            int
+            getLoadCostWeight ( uint resourceId ) const
+            {
+                assert ( exists ( resourceId ) );
+
+                return _values[ startIndex() + 1 + resourceId*getDefinitionSize() + 1 ];
+            }
            
             /**
              * Returns a human-readable representation of a resource.
@@ -167,7 +183,8 @@ namespace ROADEF12COMMON
                
         private:
             
-            const std::vector<int>& _values;
+            const ValuesView _values;
+            const uint       _size;
     
     };
 };
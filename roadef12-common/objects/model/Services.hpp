@@ -26,92 +26,77 @@
 // roadef12
 #include "roadef12-common/objects/model/Resources.hpp"
 ///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <numeric>
+///////////////////////////////////////////////////////////////////////////
 
 namespace ROADEF12COMMON
 {
     /**
-     * Service-related procedures.
+     * Service-related procedures. Services have variable size in the
+     * ROADEF format, so they are parsed once into compressed (CSR) arrays:
+     * the services each service depends on, and the reverse, the services
+     * depending on each service.
      *
      * @author daniperez
      */
     class Services
     {
-        public:
-            
-            /**
-            * Abstraction of a service. Services needs of a holder class
-            * ("Service", note the lack of "s") because its attributes cannot
-            * be retrieved in constant time (they have variable size) and thus
-            * they must be stored in Service.
-            * 
-            * @author daniperez
-            */
-            struct Service
-            {       
-                /**
-                * Constructor.
-                */
-                Service ( int id,
-                        int minSpread,
-                        std::vector<int>::const_iterator firstService,
-                        std::vector<int>::const_iterator afterLastService
-                        ) : id ( id ), minSpread (minSpread),
-                            deps ( firstService, afterLastService )
-                {
-                }
-                
-                /**
-                 * Service's id.
-                 */
-                const int        id;
-                
-                /**
-                 * Minimum spread of a service.
-                 */
-                const int        minSpread;
-                
-                /**
-                 * Services this service dependes up on.
-                 */
-                std::vector<int> deps;
-            };
-    
         public:
             
             /**
              * Constructor.
              */
             Services ( const Machines& machines,
-                       const std::vector<int>& values )
+                       const ValuesView& values )
                 : _machines ( machines ),
                   _values ( values ),
-                  _definitionSize ( 1 )
+                  _startIndex ( machines.startIndex() + 1 +
+                                machines.size()*machines.getDefinitionSize() ),
+                  _size ( _values [ _startIndex ] ),
+                  _definitionSize ( 1 ),
+                  _minSpread ( _size ),
+                  _dependencyOffset ( _size + 1, 0 ),
+                  _dependentOffset ( _size + 1, 0 )
             {
-                // Services are parsed once into individual Service's since they
-                // haven't a fixed size and they cannot be read in constant time.
-                uint numServices = _values [ startIndex() ];
-                uint numDeps = 0;
-                uint serviceId = 0;
-                    
-                for ( std::vector<int>::const_iterator
-                        it  = _values.begin() + startIndex() + 1;
-                        it != _values.end() && serviceId < numServices;
-                        it += 1+1+numDeps
-                    )
+                ValuesView::const_iterator it = _values.begin() + startIndex() + 1;
+
+                for ( uint s = 0 ; s < _size ; ++s )
                 {
-                    int minSpread = *it;
-                    numDeps = *(it+1);
-                    
-                    boost::shared_ptr<const Service> servicePtr;
-             
-                    servicePtr.reset
-                    (
-                      new Service ( serviceId++, minSpread, it+2, it+2+numDeps )
-                    );
-                    
-                    _services.push_back (  servicePtr );
-                    
+                    const uint numDeps = *(it+1);
+
+                    _minSpread [ s ] = *it;
+                    _dependencyOffset [ s+1 ] = _dependencyOffset [ s ] + numDeps;
+
+                    for ( uint d = 0 ; d < numDeps ; ++d )
+                    {
+                        _dependencies.push_back ( *(it+2+d) );
+                        ++_dependentOffset [ *(it+2+d) + 1 ];
+                    }
+
                     _definitionSize += 2+numDeps;
+                    it += 2+numDeps;
+                }
+
+                // Reverse index: counting sort of the dependencies
+                std::partial_sum ( _dependentOffset.begin(),
+                                   _dependentOffset.end(),
+                                   _dependentOffset.begin() );
+
+                std::vector<int> next ( _dependentOffset.begin(),
+                                        _dependentOffset.end() - 1 );
+
+                _dependents.resize ( _dependencies.size() );
+
+                for ( uint s = 0 ; s < _size ; ++s )
+                {
+                    for ( int d = _dependencyOffset [ s ] ;
+                          d < _dependencyOffset [ s+1 ] ;
+                          ++d )
+                    {
+                        _dependents [ next [ _dependencies [ d ] ]++ ] = s;
+                    }
                 }
             }
             
@@ -123,7 +108,7 @@ namespace ROADEF12COMMON
             uint
             size () const
             {
-                return _services.size();
+                return _size;
             }
 
         public:
@@ -132,6 +117,48 @@ namespace ROADEF12COMMON
              * @name Methods related to a single service
              */
             ///@{
+            /**
+             * Minimum number of locations the service must spread over.
+             *
+             * @param serviceId Service's id.
+             * @return Minimum spread.
+             */
+            int
+            getMinSpread ( uint serviceId ) const
+            {
+                assert ( exists ( serviceId ) );
+
+                return _minSpread [ serviceId ];
+            }
+
+            /**
+             * Services the given service depends on.
+             *
+             * @param serviceId Service's id.
+             * @return View of service ids.
+             */
+            ValuesView
+            getDependencies ( uint serviceId ) const
+            {
+                assert ( exists ( serviceId ) );
+
+                return view ( _dependencies, _dependencyOffset, serviceId );
+            }
+
+            /**
+             * Services depending on the given service.
+             *
+             * @param serviceId Service's id.
+             * @return View of service ids.
+             */
+            ValuesView
+            getDependents ( uint serviceId ) const
+            {
+                assert ( exists ( serviceId ) );
+
+                return view ( _dependents, _dependentOffset, serviceId );
+            }
+
             /**
              * Returns a human-readable representation of a service.
              * 
@@ -143,24 +170,24 @@ namespace ROADEF12COMMON
             {
                 assert ( exists ( serviceId ) );
                 
-                const Service& service = *_services[serviceId];
+                const ValuesView deps = getDependencies ( serviceId );
                 
                 std::string output;
                                 
                 output += "    #" ;
                 output += boost::lexical_cast<std::string> ( serviceId ) ;
                 output += ", minSpread=" ;
-                output += boost::lexical_cast<std::string> ( service.minSpread ) ;
+                output += boost::lexical_cast<std::string>
+                              ( getMinSpread ( serviceId ) ) ;
                 output += "\n";
                 output += "        depends on      : " ;
-                for ( uint s = 0 ; s < service.deps.size(); ++s )
+                for ( uint s = 0 ; s < deps.size(); ++s )
                 {
                     output += "s" ;
-                    output += boost::lexical_cast<std::string>
-                              ( service.deps[s] ) ;
+                    output += boost::lexical_cast<std::string> ( deps[s] ) ;
                     output += "   ";
                 }
-                if (  service.deps.size() == 0 ) output += "-";
+                if (  deps.size() == 0 ) output += "-";
                 output += "\n";
                 
                 return output ;                
@@ -191,20 +218,6 @@ namespace ROADEF12COMMON
                    return true; 
                 }                
             }
-            
-            /**
-             * Returns the service identified by serviceId.
-             * 
-             * @param serviceId the id of the service you are looking for.
-             * @return Service.
-             */ 
-            boost::shared_ptr<const Service>
-            get ( ushort serviceId ) const
-            {
-                assert ( serviceId < size() );
-                
-                return _services [ serviceId ];
-            }
             ///@}
             
         public:
@@ -215,16 +228,14 @@ namespace ROADEF12COMMON
             ///@{               
             /**
              * According to ROADEF's format, where
-             * this item's definition start.
+             * this item's definition start. Computed once at construction.
              * 
              * @return Index of the start of definition.
              */ 
             uint
             startIndex () const
             {
-                return _machines.startIndex() +
-                       1 +
-                       _machines.size()*_machines.getDefinitionSize();
+                return _startIndex;
             }
                    
             /**
@@ -239,13 +250,37 @@ namespace ROADEF12COMMON
             }
             ///@}
             
+        protected:
+
+            /**
+             * Row of a CSR index.
+             */
+            static ValuesView
+            view ( const std::vector<int>& values,
+                   const std::vector<int>& offsets,
+                   uint row )
+            {
+                return ValuesView ( values.empty() ? NULL :
+                                        &values[0] + offsets [ row ],
+                                    offsets [ row+1 ] - offsets [ row ] );
+            }
+            
         private:
             
             const Machines&         _machines;
-            const std::vector<int>& _values;
+            const ValuesView        _values;
+            const uint              _startIndex;
+            const uint              _size;
+            int                     _definitionSize;
             
-            std::vector< boost::shared_ptr<const Service> > _services;
-            int                                             _definitionSize;
+            /** Minimum spread per service. */
+            std::vector<int>        _minSpread;
+            /** Dependencies of service s: [_dependencyOffset[s], [s+1]). */
+            std::vector<int>        _dependencies;
+            std::vector<int>        _dependencyOffset;
+            /** Dependents of service s: [_dependentOffset[s], [s+1]). */
+            std::vector<int>        _dependents;
+            std::vector<int>        _dependentOffset;
     };
 };
 
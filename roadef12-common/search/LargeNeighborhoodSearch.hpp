@@ -0,0 +1,834 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_LARGE_NEIGHBORHOOD_SEARCH_HPP
+#define __roadef12_LARGE_NEIGHBORHOOD_SEARCH_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/objects/ServicePlacement.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/search/SearchStatistics.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <random>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Large Neighborhood Search: each iteration removes a set of processes
+     * (destroy) and reinserts them one by one at their cheapest feasible
+     * machine (repair), inside an Assignment transaction that is committed
+     * if the objective didn't get worse and rolled back otherwise.
+     *
+     * Removed processes stay on their machine in the Assignment but are
+     * "ghosts": the repair works on the virtual assignment without them,
+     * whose loads, transient usage and per-service placement are the
+     * Assignment's minus the ghosts' (kept incrementally). A ghost still
+     * holds its transient usage on its original machine, wherever it is
+     * reinserted. Insertions are checked against the virtual assignment
+     * (capacity, conflict, dependencies, and enough ghosts left to reach
+     * the minimum spread), and destroy never removes the last process of a
+     * service a dependent needs, so a completed repair is feasible. The
+     * exact change of the objective is the sum of Evaluator::deltaShift of
+     * the physical moves. Repair only visits the machines the slack index
+     * of the Assignment says the ghost fits on, and those holding ghosts.
+     *
+     * Destroy operators pick the processes of random machines, of random
+     * services, of a random location, or at random. The destroy size
+     * shrinks by one after an improvement and grows by one after a run of
+     * iterations without any.
+     *
+     * @author daniperez
+     */
+    class LargeNeighborhoodSearch
+    {
+        public:
+
+            /**
+             * Destroy operators.
+             */
+            enum Operator
+            {
+                BY_MACHINE,
+                BY_SERVICE,
+                BY_LOCATION,
+                AT_RANDOM,
+                NUM_OPERATORS
+            };
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the search.
+             * @param candidates Candidate machines, must outlive the search.
+             * @param seed Seed of the random choices.
+             */
+            LargeNeighborhoodSearch ( const Parameters& parameters,
+                                      const CandidateLists& candidates,
+                                      uint seed )
+                : _parameters ( parameters ),
+                  _model ( parameters.compiled ),
+                  _services ( parameters.services ),
+                  _evaluator ( parameters ),
+                  _candidates ( candidates ),
+                  _random ( seed ),
+                  _maxSize ( std::max ( 1u, std::min<uint> ( MAX_SIZE,
+                                                             _model.getNumProcesses() ) ) ),
+                  _size ( std::min<uint> ( MIN_SIZE, _maxSize ) ),
+                  _ghost ( _model.getNumProcesses(), 0 ),
+                  _ghostLoad ( _model.getNumMachines()*_model.getNumResources(), 0 ),
+                  _ghostHome ( _model.getNumMachines()*_model.getNumResources(), 0 ),
+                  _ghosts ( _model.getNumServices(), _model.getNumLocations(),
+                            _model.getNumNeighborhoods() ),
+                  _ghostsPerService ( _model.getNumServices(), 0 ),
+                  _virtualLocations ( _model.getNumServices(), 0 ),
+                  _locationOffset ( _model.getNumLocations() + 1, 0 ),
+                  _weight ( _model.getNumProcesses(), 0 ),
+                  _load ( _model.getNumResources(), 0 ),
+                  _zeros ( _model.getNumResources(), 0 ),
+                  _fitting ( _model.getNumMachines(), 0 ),
+                  _fitStamp ( _model.getNumMachines(), 0 ),
+                  _stamp ( 0 ),
+                  _numIterations ( 0 ),
+                  _numImprovements ( 0 ),
+                  _numFailedRepairs ( 0 )
+            {
+                _statistics.clear ();
+
+                // Machines per location, counting sort
+                for ( uint m = 0 ; m < _model.getNumMachines() ; ++m )
+                {
+                    ++_locationOffset [ _model.getLocation ( m ) + 1 ];
+                }
+
+                std::partial_sum ( _locationOffset.begin(), _locationOffset.end(),
+                                   _locationOffset.begin() );
+
+                std::vector<uint> next ( _locationOffset.begin(),
+                                         _locationOffset.end() - 1 );
+
+                _machinesPerLocation.resize ( _model.getNumMachines() );
+
+                for ( uint m = 0 ; m < _model.getNumMachines() ; ++m )
+                {
+                    _machinesPerLocation [ next [ _model.getLocation ( m ) ]++ ] = m;
+                }
+
+                // Repair inserts the biggest processes first: share of the
+                // total capacity they take, summed over the resources
+                std::vector<double> total ( _model.getNumResources(), 0 );
+
+                for ( uint m = 0 ; m < _model.getNumMachines() ; ++m )
+                {
+                    for ( uint r = 0 ; r < _model.getNumResources() ; ++r )
+                    {
+                        total [ r ] += _model.getCapacities ( m ) [ r ];
+                    }
+                }
+
+                for ( uint p = 0 ; p < _model.getNumProcesses() ; ++p )
+                {
+                    for ( uint r = 0 ; r < _model.getNumResources() ; ++r )
+                    {
+                        if ( total [ r ] > 0 )
+                        {
+                            _weight [ p ] += _model.getRequirements ( p ) [ r ] / total [ r ];
+                        }
+                    }
+                }
+            }
+
+            /**
+             * Improves a feasible assignment until the deadline.
+             *
+             * @param assignment Feasible assignment, improved in place. It
+             *        must not be in a transaction.
+             * @param deadline Time to stop at.
+             * @return Change of the objective, <= 0.
+             */
+            int64_t
+            run ( Assignment& assignment, SearchClock::time_point deadline )
+            {
+                const SearchClock::time_point start = SearchClock::now();
+
+                int64_t total = 0;
+                uint    stall = 0;
+
+                while ( SearchClock::now() < deadline )
+                {
+                    const Operator op = Operator ( _random() % NUM_OPERATORS );
+
+                    const int64_t delta = iterate ( assignment, op );
+
+                    total += delta;
+
+                    // Adaptive destroy size
+                    if ( delta < 0 )
+                    {
+                        stall = 0;
+                        _size = std::max<uint> ( std::min<uint> ( MIN_SIZE, _maxSize ),
+                                                 _size - 1 );
+                    }
+                    else if ( ++stall == STALL )
+                    {
+                        stall = 0;
+                        _size = std::min ( _maxSize, _size + 1 );
+                    }
+                }
+
+                _statistics.seconds
+                    += std::chrono::duration<double> ( SearchClock::now() - start ).count();
+
+                return total;
+            }
+
+            /**
+             * One destroy and repair, kept if the objective didn't get
+             * worse.
+             *
+             * @param assignment Feasible assignment.
+             * @param op Destroy operator.
+             * @return Change of the objective, <= 0.
+             */
+            int64_t
+            iterate ( Assignment& assignment, Operator op )
+            {
+                ++_numIterations;
+
+                destroy ( assignment, op );
+
+                assignment.begin ();
+
+                int64_t delta    = 0;
+                bool    repaired = repair ( assignment, delta );
+
+                if ( repaired && delta <= 0 )
+                {
+                    assignment.commit ();
+                    ++_statistics.applied;
+                    _numImprovements += ( delta < 0 );
+
+                    return delta;
+                }
+
+                if ( ! repaired )
+                {
+                    ++_numFailedRepairs;
+                }
+
+                assignment.rollback ();
+
+                return 0;
+            }
+
+            /**
+             * @name Counters, accumulated over the runs.
+             */
+            ///@{
+            /**
+             * Insertions evaluated and iterations kept.
+             *
+             * @return Statistics.
+             */
+            const SearchStatistics&
+            getStatistics () const
+            {
+                return _statistics;
+            }
+
+            /**
+             * @return Destroy and repair iterations.
+             */
+            uint64_t
+            getNumIterations () const
+            {
+                return _numIterations;
+            }
+
+            /**
+             * @return Iterations that lowered the objective.
+             */
+            uint64_t
+            getNumImprovements () const
+            {
+                return _numImprovements;
+            }
+
+            /**
+             * @return Iterations where some process couldn't be reinserted.
+             */
+            uint64_t
+            getNumFailedRepairs () const
+            {
+                return _numFailedRepairs;
+            }
+
+            /**
+             * @return Current destroy size.
+             */
+            uint
+            getDestroySize () const
+            {
+                return _size;
+            }
+            ///@}
+
+        protected:
+
+            /**
+             * Destroy size bounds, and the number of iterations without
+             * improvement after which the size grows.
+             */
+            enum
+            {
+                MIN_SIZE = 2,
+                MAX_SIZE = 64,
+                STALL    = 100
+            };
+
+            /**
+             * @name Destroy.
+             */
+            ///@{
+            /**
+             * Turns about getDestroySize() processes into ghosts.
+             *
+             * @param assignment Assignment.
+             * @param op Operator choosing them.
+             */
+            void
+            destroy ( const Assignment& assignment, Operator op )
+            {
+                _removed.clear ();
+
+                const uint numProcesses = _model.getNumProcesses();
+
+                for ( uint tries = 0 ;
+                      _removed.size() < _size && tries < 4*_size ;
+                      ++tries )
+                {
+                    const uint process = _random() % numProcesses;
+
+                    switch ( op )
+                    {
+                        case BY_MACHINE:
+                        {
+                            removeAll ( assignment,
+                                        assignment.getProcessesPerMachine
+                                            ( assignment.getMachine ( process ) ) );
+                            break;
+                        }
+                        case BY_SERVICE:
+                        {
+                            removeAll ( assignment,
+                                        assignment.getProcessesPerService
+                                            ( _model.getService ( process ) ) );
+                            break;
+                        }
+                        case BY_LOCATION:
+                        {
+                            // Machines of the location, from a random one on
+                            const uint location
+                                = _model.getLocation ( assignment.getMachine ( process ) );
+                            const uint first = _locationOffset [ location ];
+                            const uint count = _locationOffset [ location+1 ] - first;
+                            const uint shift = _random() % count;
+
+                            for ( uint i = 0 ; i < count && _removed.size() < _size ; ++i )
+                            {
+                                removeAll ( assignment,
+                                            assignment.getProcessesPerMachine
+                                                ( _machinesPerLocation
+                                                      [ first + ( shift + i ) % count ] ) );
+                            }
+
+                            tries = 4*_size;
+                            break;
+                        }
+                        default:
+                        {
+                            remove ( assignment, process );
+                            break;
+                        }
+                    }
+                }
+            }
+
+            /**
+             * Removes processes of the range until the destroy size is
+             * reached.
+             */
+            void
+            removeAll ( const Assignment& assignment, const ProcessRange& processes )
+            {
+                for ( uint i = 0 ; i < processes.size() && _removed.size() < _size ; ++i )
+                {
+                    remove ( assignment, processes [ i ] );
+                }
+            }
+
+            /**
+             * Turns the process into a ghost, unless it already is one or
+             * it is the last process of its service in the neighborhood
+             * and some dependent service has processes there.
+             *
+             * @return True if removed.
+             */
+            bool
+            remove ( const Assignment& assignment, uint process )
+            {
+                if ( _ghost [ process ] )
+                {
+                    return false;
+                }
+
+                const uint service      = _model.getService ( process );
+                const uint machine      = assignment.getMachine ( process );
+                const uint location     = _model.getLocation ( machine );
+                const uint neighborhood = _model.getNeighborhood ( machine );
+
+                if ( getVirtualInNeighborhood ( assignment, service, neighborhood ) == 1 )
+                {
+                    const ValuesView dependents = _services.getDependents ( service );
+
+                    for ( uint d = 0 ; d < dependents.size() ; ++d )
+                    {
+                        if ( getVirtualInNeighborhood ( assignment, dependents [ d ],
+                                                        neighborhood ) > 0 )
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                if ( _ghostsPerService [ service ]++ == 0 )
+                {
+                    _virtualLocations [ service ]
+                        = assignment.getNumLocationsPerService ( service );
+                }
+
+                _ghosts.add ( service, location, neighborhood );
+
+                if ( getVirtualInLocation ( assignment, service, location ) == 0 )
+                {
+                    --_virtualLocations [ service ];
+                }
+
+                updateGhostLoad ( assignment, process, machine, 1 );
+
+                _ghost [ process ] = 1;
+                _removed.push_back ( process );
+
+                return true;
+            }
+            ///@}
+
+            /**
+             * @name Repair.
+             */
+            ///@{
+            /**
+             * Reinserts the ghosts, biggest first, each at its cheapest
+             * feasible candidate machine. On failure, the remaining ghosts
+             * are released (the caller rolls the moves back).
+             *
+             * @param assignment Assignment, in a transaction.
+             * @param delta Output, exact change of the objective.
+             * @return False if some ghost had no feasible machine.
+             */
+            bool
+            repair ( Assignment& assignment, int64_t& delta )
+            {
+                std::sort ( _removed.begin(), _removed.end(), ByWeight ( _weight ) );
+
+                for ( uint i = 0 ; i < _removed.size() ; ++i )
+                {
+                    const uint process = _removed [ i ];
+                    const int  machine = findBestInsertion ( assignment, process );
+
+                    if ( machine < 0 )
+                    {
+                        for ( uint j = i ; j < _removed.size() ; ++j )
+                        {
+                            release ( assignment, _removed [ j ] );
+                        }
+
+                        return false;
+                    }
+
+                    insert ( assignment, process, machine, delta );
+                }
+
+                return true;
+            }
+
+            /**
+             * Cheapest candidate machine where the ghost can be inserted
+             * in the virtual assignment. Cost is the load and balance
+             * change of the machine plus the move costs. Only the
+             * candidates among findFittingMachines are checked.
+             *
+             * @return Machine, -1 if none.
+             */
+            int
+            findBestInsertion ( const Assignment& assignment, uint process )
+            {
+                const uint         original   = assignment.getOriginalMachine ( process );
+                const uint         service    = _model.getService ( process );
+                const int*         requirements = _model.getRequirements ( process );
+                const uint         numResources = _model.getNumResources();
+
+                // Other moved processes of the service, and the current max
+                const int64_t moved
+                    = assignment.getNumMovedProcesses ( service ) -
+                      ( assignment.getMachine ( process ) != original );
+                const int64_t maxMoved
+                    = assignment.getServiceMoveTracker().getMax();
+
+                int     best     = -1;
+                int64_t bestCost = std::numeric_limits<int64_t>::max();
+
+                const uint found = findFittingMachines ( assignment, process );
+
+                for ( uint f = 0 ; f < found ; ++f )
+                {
+                    const uint machine = _fitting [ f ];
+
+                    if ( ! _candidates.isCandidate ( process, machine ) ||
+                         ! canInsert ( assignment, process, machine ) )
+                    {
+                        continue;
+                    }
+
+                    ++_statistics.evaluated;
+
+                    const uint* load  = assignment.getUtilizations ( machine );
+                    const uint* ghost = &_ghostLoad [ machine*numResources ];
+
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        _load [ r ] = load [ r ] - ghost [ r ];
+                    }
+
+                    int64_t cost
+                        = _evaluator.getMachineDelta ( machine, &_load[0],
+                                                       requirements, &_zeros[0] ) +
+                          int64_t ( _parameters.machines.getMovingCost ( original, machine ) ) *
+                              _model.getMachineMoveCostWeight();
+
+                    if ( machine != original )
+                    {
+                        cost += int64_t ( _model.getPMC ( process ) ) *
+                                    _model.getProcessMoveCostWeight() +
+                                std::max<int64_t> ( moved + 1 - maxMoved, 0 ) *
+                                    _model.getServiceMoveCostWeight();
+                    }
+
+                    // Ties go to the lowest id, as in a walk of the
+                    // sorted candidate list
+                    if ( cost < bestCost ||
+                         ( cost == bestCost && int ( machine ) < best ) )
+                    {
+                        best     = machine;
+                        bestCost = cost;
+                    }
+                }
+
+                return best;
+            }
+
+            /**
+             * Machines where the ghost may fit in the virtual assignment:
+             * those where it fits in the physical one
+             * (Assignment::findFittingMachines, sublinear in M), and those
+             * holding ghosts, whose load the physical slack still counts.
+             * canInsert fails on any other machine.
+             *
+             * @return Number of machines written to _fitting, each once.
+             */
+            uint
+            findFittingMachines ( const Assignment& assignment, uint process )
+            {
+                if ( ++_stamp == 0 )
+                {
+                    std::fill ( _fitStamp.begin(), _fitStamp.end(), 0 );
+                    _stamp = 1;
+                }
+
+                uint found = assignment.findFittingMachines ( process, &_fitting[0] );
+
+                for ( uint i = 0 ; i < found ; ++i )
+                {
+                    _fitStamp [ _fitting [ i ] ] = _stamp;
+                }
+
+                for ( uint i = 0 ; i < _removed.size() ; ++i )
+                {
+                    if ( ! _ghost [ _removed [ i ] ] )
+                    {
+                        continue;
+                    }
+
+                    const uint machine = assignment.getMachine ( _removed [ i ] );
+
+                    if ( _fitStamp [ machine ] != _stamp )
+                    {
+                        _fitStamp [ machine ] = _stamp;
+                        _fitting [ found++ ]  = machine;
+                    }
+                }
+
+                return found;
+            }
+
+            /**
+             * Says if the ghost fits on the machine in the virtual
+             * assignment and keeps the completion of the repair feasible.
+             * O(R + processes of the service + dependencies).
+             */
+            bool
+            canInsert ( const Assignment& assignment, uint process, uint machine ) const
+            {
+                const uint  numResources = _model.getNumResources();
+                const int*  requirements = _model.getRequirements ( process );
+                const int*  capacities   = _model.getCapacities ( machine );
+                const int*  transient    = _model.getTransientFlags ();
+                const uint* load         = assignment.getUtilizations ( machine );
+                const uint* kept         = assignment.getTransientUtilizations ( machine );
+                const uint* ghost        = &_ghostLoad [ machine*numResources ];
+                const uint* home         = &_ghostHome [ machine*numResources ];
+
+                // The ghost's transient usage is already counted on its
+                // original machine
+                const int   back = ( assignment.getOriginalMachine ( process ) == machine );
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    const int64_t total
+                        = int64_t ( load [ r ] ) - ghost [ r ] + kept [ r ] + home [ r ] +
+                          requirements [ r ] - back * transient [ r ] * requirements [ r ];
+
+                    if ( total > capacities [ r ] )
+                    {
+                        return false;
+                    }
+                }
+
+                const uint service = _model.getService ( process );
+
+                // Conflict
+                BOOST_FOREACH ( ushort other, assignment.getProcessesPerService ( service ) )
+                {
+                    if ( ! _ghost [ other ] && assignment.getMachine ( other ) == machine )
+                    {
+                        return false;
+                    }
+                }
+
+                // Spread: the ghosts left must be able to make up for it
+                const int missing = _services.getMinSpread ( service ) -
+                                    _virtualLocations [ service ];
+
+                if ( missing > 0 &&
+                     getVirtualInLocation ( assignment, service,
+                                            _model.getLocation ( machine ) ) > 0 &&
+                     int ( _ghostsPerService [ service ] ) - 1 < missing )
+                {
+                    return false;
+                }
+
+                // Dependencies
+                const uint       neighborhood = _model.getNeighborhood ( machine );
+                const ValuesView dependencies = _services.getDependencies ( service );
+
+                for ( uint d = 0 ; d < dependencies.size() ; ++d )
+                {
+                    if ( getVirtualInNeighborhood ( assignment, dependencies [ d ],
+                                                    neighborhood ) == 0 )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Moves the ghost to the machine and makes it a process of the
+             * virtual assignment again.
+             */
+            void
+            insert ( Assignment& assignment, uint process, uint machine, int64_t& delta )
+            {
+                const uint service = _model.getService ( process );
+
+                if ( getVirtualInLocation ( assignment, service,
+                                            _model.getLocation ( machine ) ) == 0 )
+                {
+                    ++_virtualLocations [ service ];
+                }
+
+                release ( assignment, process );
+
+                delta += _evaluator.deltaShift ( assignment, process, machine );
+
+                assignment.move ( process, machine );
+            }
+
+            /**
+             * Clears the ghost bookkeeping of the process.
+             */
+            void
+            release ( const Assignment& assignment, uint process )
+            {
+                const uint service = _model.getService ( process );
+                const uint machine = assignment.getMachine ( process );
+
+                _ghosts.remove ( service, _model.getLocation ( machine ),
+                                 _model.getNeighborhood ( machine ) );
+
+                updateGhostLoad ( assignment, process, machine, -1 );
+
+                --_ghostsPerService [ service ];
+                _ghost [ process ] = 0;
+            }
+            ///@}
+
+            /**
+             * Adds (sign=1) or removes (sign=-1) the ghost's load from the
+             * machine it sits on, and its transient usage if that is its
+             * original machine.
+             */
+            void
+            updateGhostLoad ( const Assignment& assignment,
+                              uint process,
+                              uint machine,
+                              int sign )
+            {
+                const uint numResources = _model.getNumResources();
+                const int* requirements = _model.getRequirements ( process );
+                const int* transient    = _model.getTransientFlags ();
+                const int  home         = ( assignment.getOriginalMachine ( process ) ==
+                                            machine );
+                uint*      ghost        = &_ghostLoad [ machine*numResources ];
+                uint*      kept         = &_ghostHome [ machine*numResources ];
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    ghost [ r ] += sign * requirements [ r ];
+                    kept [ r ]  += sign * home * transient [ r ] * requirements [ r ];
+                }
+            }
+
+            /**
+             * Processes of the service in the location, ghosts excluded.
+             */
+            uint
+            getVirtualInLocation ( const Assignment& assignment,
+                                   uint service,
+                                   uint location ) const
+            {
+                return assignment.getNumProcessesInLocation ( service, location ) -
+                       _ghosts.getInLocation ( service, location );
+            }
+
+            /**
+             * Processes of the service in the neighborhood, ghosts excluded.
+             */
+            uint
+            getVirtualInNeighborhood ( const Assignment& assignment,
+                                       uint service,
+                                       uint neighborhood ) const
+            {
+                return assignment.getNumProcessesInNeighborhood ( service, neighborhood ) -
+                       _ghosts.getInNeighborhood ( service, neighborhood );
+            }
+
+            /**
+             * Orders processes by decreasing weight.
+             */
+            struct ByWeight
+            {
+                ByWeight ( const std::vector<double>& weight ) : _weight ( weight ) {}
+
+                bool
+                operator() ( uint a, uint b ) const
+                {
+                    return _weight [ a ] > _weight [ b ];
+                }
+
+                const std::vector<double>& _weight;
+            };
+
+        private:
+
+            const Parameters&       _parameters;
+            const CompiledModel&    _model;
+            const Services&         _services;
+            Evaluator               _evaluator;
+            const CandidateLists&   _candidates;
+            std::mt19937            _random;
+            /** Destroy size, in [MIN_SIZE, _maxSize]. */
+            const uint              _maxSize;
+            uint                    _size;
+            /** Processes removed by the current destroy. */
+            std::vector<uint>       _removed;
+            /** 1 for ghosts. */
+            std::vector<char>       _ghost;
+            /** Load of the ghosts on each machine, [M][R]. */
+            std::vector<uint>       _ghostLoad;
+            /** Transient usage of the ghosts sitting on their original machine, [M][R]. */
+            std::vector<uint>       _ghostHome;
+            /** Ghosts per (service, location) and (service, neighborhood). */
+            ServicePlacement        _ghosts;
+            std::vector<uint>       _ghostsPerService;
+            /** Locations used by the service, ghosts excluded (if it has ghosts). */
+            std::vector<int>        _virtualLocations;
+            /** Machines of location l: [_locationOffset[l], [l+1]). */
+            std::vector<uint>       _machinesPerLocation;
+            std::vector<uint>       _locationOffset;
+            /** Share of the total capacity each process takes. */
+            std::vector<double>     _weight;
+            /** Scratch: virtual load of a machine. */
+            std::vector<uint>       _load;
+            std::vector<int>        _zeros;
+            /** Scratch: machines found by findFittingMachines. */
+            std::vector<ushort>     _fitting;
+            /** Machines already in _fitting are marked with _stamp. */
+            std::vector<uint>       _fitStamp;
+            uint                    _stamp;
+            SearchStatistics        _statistics;
+            uint64_t                _numIterations;
+            uint64_t                _numImprovements;
+            uint64_t                _numFailedRepairs;
+    };
+};
+
+#endif
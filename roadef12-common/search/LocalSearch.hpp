@@ -0,0 +1,349 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_LOCAL_SEARCH_HPP
+#define __roadef12_LOCAL_SEARCH_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/SearchStatistics.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Descent over the shift (one process to another machine) and swap
+     * (two processes exchange machines) neighborhoods, restricted to the
+     * static candidates of each process (see CandidateLists). Moves are
+     * priced by Evaluator's deltas and only the improving ones are checked
+     * by FeasibilityOracle, so a feasible assignment stays feasible.
+     *
+     * First improvement visits the processes in a random order, seeded,
+     * and applies the first improving move found. Best improvement applies
+     * the best move of the whole neighborhood at each step. Both stop at
+     * a local optimum or at the deadline.
+     *
+     * @author daniperez
+     */
+    class LocalSearch
+    {
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the search.
+             * @param candidates Candidate machines, must outlive the search.
+             * @param seed Seed of the visiting order.
+             */
+            LocalSearch ( const Parameters& parameters,
+                          const CandidateLists& candidates,
+                          uint seed )
+                : _evaluator ( parameters ),
+                  _oracle ( parameters ),
+                  _candidates ( candidates ),
+                  _random ( seed ),
+                  _order ( parameters.processes.size() ),
+                  _bestImprovement ( false )
+            {
+                std::iota ( _order.begin(), _order.end(), 0 );
+                _statistics.clear ();
+            }
+
+            /**
+             * Chooses between first (default) and best improvement.
+             *
+             * @param bestImprovement True for best improvement.
+             */
+            void
+            setBestImprovement ( bool bestImprovement )
+            {
+                _bestImprovement = bestImprovement;
+            }
+
+            /**
+             * Improves a feasible assignment until no move improves it or
+             * the deadline passes.
+             *
+             * @param assignment Feasible assignment, improved in place.
+             * @param deadline Time to stop at.
+             * @return Change of the objective, <= 0.
+             */
+            int64_t
+            run ( Assignment& assignment, SearchClock::time_point deadline )
+            {
+                const SearchClock::time_point start = SearchClock::now();
+
+                int64_t total = 0;
+                int64_t delta;
+
+                do
+                {
+                    delta = _bestImprovement
+                            ? bestImprovementStep ( assignment, deadline )
+                            : firstImprovementPass ( assignment, deadline );
+
+                    total += delta;
+                }
+                while ( delta < 0 && SearchClock::now() < deadline );
+
+                _statistics.seconds
+                    += std::chrono::duration<double> ( SearchClock::now() - start ).count();
+
+                return total;
+            }
+
+            /**
+             * Counters, accumulated over the runs.
+             *
+             * @return Statistics.
+             */
+            const SearchStatistics&
+            getStatistics () const
+            {
+                return _statistics;
+            }
+
+        protected:
+
+            /**
+             * A shift (target is a machine) or a swap (target is a process).
+             */
+            struct Move
+            {
+                int64_t delta;
+                uint    process;
+                uint    target;
+                bool    swap;
+            };
+
+            /**
+             * Visits every process once, in random order, applying the
+             * first improving move of each.
+             *
+             * @return Change of the objective.
+             */
+            int64_t
+            firstImprovementPass ( Assignment& assignment,
+                                   SearchClock::time_point deadline )
+            {
+                std::shuffle ( _order.begin(), _order.end(), _random );
+
+                int64_t total = 0;
+
+                for ( uint i = 0 ; i < _order.size() ; ++i )
+                {
+                    Move move = { 0, 0, 0, false };
+
+                    if ( scan ( assignment, _order [ i ], move, true ) )
+                    {
+                        total += move.delta;
+                    }
+
+                    if ( SearchClock::now() >= deadline )
+                    {
+                        break;
+                    }
+                }
+
+                return total;
+            }
+
+            /**
+             * Applies the best move of the whole neighborhood, if it
+             * improves.
+             *
+             * @return Change of the objective.
+             */
+            int64_t
+            bestImprovementStep ( Assignment& assignment,
+                                  SearchClock::time_point deadline )
+            {
+                Move best = { 0, 0, 0, false };
+
+                for ( uint p = 0 ; p < _order.size() ; ++p )
+                {
+                    scan ( assignment, p, best, false );
+
+                    if ( SearchClock::now() >= deadline )
+                    {
+                        break;
+                    }
+                }
+
+                if ( best.delta < 0 )
+                {
+                    apply ( assignment, best );
+                }
+
+                return best.delta;
+            }
+
+            /**
+             * Looks for feasible moves of the process better than best.
+             * In first improvement the first one found is applied.
+             *
+             * @param assignment Current assignment.
+             * @param process Process to move.
+             * @param best Best move so far, updated.
+             * @param first True to apply and stop at the first one.
+             * @return True if a move was applied.
+             */
+            bool
+            scan ( Assignment& assignment, uint process, Move& best, bool first )
+            {
+                const uint         from       = assignment.getMachine ( process );
+                const MachineRange candidates = _candidates.getCandidates ( process );
+
+                // Shifts
+                for ( uint c = 0 ; c < candidates.size() ; ++c )
+                {
+                    const uint machine = candidates [ c ];
+
+                    if ( machine == from )
+                    {
+                        continue;
+                    }
+
+                    const int64_t delta
+                        = _evaluator.deltaShift ( assignment, process, machine );
+
+                    ++_statistics.evaluated;
+
+                    if ( delta < best.delta &&
+                         _oracle.canMove ( assignment, process, machine ) )
+                    {
+                        Move move = { delta, process, machine, false };
+
+                        best = move;
+
+                        if ( first )
+                        {
+                            apply ( assignment, best );
+                            return true;
+                        }
+                    }
+                }
+
+                // Swaps with the processes of the candidate machines that
+                // have the process' machine as candidate
+                for ( uint c = 0 ; c < candidates.size() ; ++c )
+                {
+                    const uint machine = candidates [ c ];
+
+                    if ( machine == from )
+                    {
+                        continue;
+                    }
+
+                    const ProcessRange others
+                        = assignment.getProcessesPerMachine ( machine );
+
+                    for ( uint o = 0 ; o < others.size() ; ++o )
+                    {
+                        const uint         other   = others [ o ];
+                        const MachineRange reverse = _candidates.getCandidates ( other );
+
+                        if ( ! std::binary_search ( reverse.begin(), reverse.end(), from ) )
+                        {
+                            continue;
+                        }
+
+                        const int64_t delta
+                            = _evaluator.deltaSwap ( assignment, process, other );
+
+                        ++_statistics.evaluated;
+
+                        if ( delta >= best.delta )
+                        {
+                            continue;
+                        }
+
+                        assignment.swap ( process, other );
+
+                        const bool legal
+                            = _oracle.keepsFeasibleAfterSwap ( assignment,
+                                                               process, other );
+
+                        if ( legal && first )
+                        {
+                            best.delta = delta;
+                            ++_statistics.applied;
+                            return true;
+                        }
+
+                        assignment.swap ( process, other );
+
+                        if ( legal )
+                        {
+                            Move move = { delta, process, other, true };
+
+                            best = move;
+                        }
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * Applies a move.
+             */
+            void
+            apply ( Assignment& assignment, const Move& move )
+            {
+                if ( move.swap )
+                {
+                    assignment.swap ( move.process, move.target );
+                }
+                else
+                {
+                    assignment.move ( move.process, move.target );
+                }
+
+                ++_statistics.applied;
+            }
+
+        private:
+
+            Evaluator               _evaluator;
+            FeasibilityOracle       _oracle;
+            const CandidateLists&   _candidates;
+            /** Visiting order of first improvement. */
+            std::mt19937            _random;
+            std::vector<uint>       _order;
+            bool                    _bestImprovement;
+            SearchStatistics        _statistics;
+    };
+};
+
+#endif
@@ -0,0 +1,466 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_MULTI_START_SEARCH_HPP
+#define __roadef12_MULTI_START_SEARCH_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/LocalSearch.hpp"
+#include "roadef12-common/search/SearchStatistics.hpp"
+#include "roadef12-common/search/WorkStealingDeque.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <thread>
+#include <random>
+#include <limits>
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/shared_ptr.hpp>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Multi-start local search on several threads. Every worker owns an
+     * Assignment copy, an evaluator and a LocalSearch; the Parameters and
+     * CandidateLists are shared read-only. A task is "perturb this
+     * solution with that many random feasible shifts, then descend".
+     * Workers pop tasks from their own WorkStealingDeque and steal from
+     * the others when it is empty; when every deque is empty they perturb
+     * their own best solution. A task that improves its starting solution
+     * pushes two follow-ups from its result, a mild and a stronger one,
+     * for its worker or a thief to pick up. Each worker keeps its best
+     * solution; they are merged when the deadline passes.
+     *
+     * @author daniperez
+     */
+    class MultiStartSearch
+    {
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the search.
+             * @param candidates Candidate machines, must outlive the search.
+             * @param seed Seed, worker t uses seed + t.
+             * @param numThreads Number of workers, 0 to use the available
+             *        hardware threads.
+             */
+            MultiStartSearch ( const Parameters& parameters,
+                               const CandidateLists& candidates,
+                               uint seed,
+                               uint numThreads )
+                : _parameters ( parameters ),
+                  _candidates ( candidates ),
+                  _seed ( seed ),
+                  _numThreads ( numThreads > 0 ? numThreads :
+                                std::max ( 1u, std::thread::hardware_concurrency() ) ),
+                  _bestImprovement ( false ),
+                  _numTasks ( 0 ),
+                  _numSteals ( 0 )
+            {
+                _statistics.clear ();
+            }
+
+            /**
+             * Chooses between first (default) and best improvement for
+             * the descents.
+             *
+             * @param bestImprovement True for best improvement.
+             */
+            void
+            setBestImprovement ( bool bestImprovement )
+            {
+                _bestImprovement = bestImprovement;
+            }
+
+            /**
+             * Searches from a feasible assignment until the deadline.
+             *
+             * @param assignment Feasible assignment, replaced by the best
+             *        one found.
+             * @param deadline Time to stop at.
+             * @return Change of the objective, <= 0.
+             */
+            int64_t
+            run ( Assignment& assignment, SearchClock::time_point deadline )
+            {
+                const SearchClock::time_point start = SearchClock::now();
+
+                Evaluator evaluator ( _parameters );
+
+                const int64_t  initialCost = evaluator.evaluate ( assignment ).total();
+                const Snapshot initial     = snapshot ( assignment );
+
+                _workers.clear ();
+                _deques.clear ();
+
+                for ( uint t = 0 ; t < _numThreads ; ++t )
+                {
+                    _workers.push_back ( boost::shared_ptr<Worker>
+                        ( new Worker ( _parameters, _candidates, assignment,
+                                       _seed + t ) ) );
+                    _workers.back()->search.setBestImprovement ( _bestImprovement );
+                    _workers.back()->best     = initial;
+                    _workers.back()->bestCost = initialCost;
+
+                    _deques.push_back ( boost::shared_ptr<Deque> ( new Deque ) );
+
+                    // Worker 0 descends from the input as is
+                    Task task = { initial, initialCost,
+                                  t == 0 ? 0 : getRandomStrength ( *_workers.back() ) };
+
+                    _deques.back()->push ( task );
+                }
+
+                std::vector<std::thread> threads;
+
+                for ( uint t = 1 ; t < _numThreads ; ++t )
+                {
+                    threads.push_back ( std::thread ( &MultiStartSearch::work,
+                                                      this, t, deadline ) );
+                }
+
+                work ( 0, deadline );
+
+                for ( uint t = 0 ; t < threads.size() ; ++t )
+                {
+                    threads [ t ].join();
+                }
+
+                // Merge
+                uint best = 0;
+
+                for ( uint t = 0 ; t < _numThreads ; ++t )
+                {
+                    const Worker& worker = *_workers [ t ];
+
+                    if ( worker.bestCost < _workers [ best ]->bestCost )
+                    {
+                        best = t;
+                    }
+
+                    _statistics.evaluated += worker.search.getStatistics().evaluated;
+                    _statistics.applied   += worker.search.getStatistics().applied;
+                    _numTasks             += worker.tasks;
+                    _numSteals            += worker.steals;
+                }
+
+                _statistics.seconds
+                    += std::chrono::duration<double> ( SearchClock::now() - start ).count();
+
+                load ( assignment, *_workers [ best ]->best );
+
+                const int64_t delta = _workers [ best ]->bestCost - initialCost;
+
+                _workers.clear ();
+                _deques.clear ();
+
+                return delta;
+            }
+
+            /**
+             * Counters of all the workers, accumulated over the runs.
+             * Seconds are wall-clock, so getEvaluationsPerSecond() is the
+             * throughput of the whole pool.
+             *
+             * @return Statistics.
+             */
+            const SearchStatistics&
+            getStatistics () const
+            {
+                return _statistics;
+            }
+
+            /**
+             * @return Number of workers.
+             */
+            uint
+            getNumThreads () const
+            {
+                return _numThreads;
+            }
+
+            /**
+             * @return Tasks run, accumulated over the runs.
+             */
+            uint64_t
+            getNumTasks () const
+            {
+                return _numTasks;
+            }
+
+            /**
+             * @return Tasks stolen from another worker's deque.
+             */
+            uint64_t
+            getNumSteals () const
+            {
+                return _numSteals;
+            }
+
+        protected:
+
+            /**
+             * Machine of every process.
+             */
+            typedef boost::shared_ptr< const std::vector<ushort> > Snapshot;
+
+            /**
+             * Perturb start with strength random shifts, then descend.
+             */
+            struct Task
+            {
+                Snapshot start;
+                int64_t  cost;
+                uint     strength;
+            };
+
+            typedef WorkStealingDeque<Task> Deque;
+
+            /**
+             * Per-thread state.
+             */
+            struct Worker
+            {
+                Worker ( const Parameters& parameters,
+                         const CandidateLists& candidates,
+                         const Assignment& assignment,
+                         uint seed )
+                    : current ( assignment ),
+                      evaluator ( parameters ),
+                      oracle ( parameters ),
+                      search ( parameters, candidates, seed ),
+                      random ( seed ),
+                      bestCost ( std::numeric_limits<int64_t>::max() ),
+                      tasks ( 0 ),
+                      steals ( 0 )
+                {
+                }
+
+                Assignment        current;
+                Evaluator         evaluator;
+                FeasibilityOracle oracle;
+                LocalSearch       search;
+                std::mt19937      random;
+                Snapshot          best;
+                int64_t           bestCost;
+                uint64_t          tasks;
+                uint64_t          steals;
+            };
+
+            /**
+             * Bounds of the perturbation strength, and the number of
+             * tasks a worker lets pile up in its deque.
+             */
+            enum
+            {
+                MIN_STRENGTH = 2,
+                MAX_STRENGTH = 32,
+                MAX_PENDING  = 8
+            };
+
+            /**
+             * Worker loop: runs tasks until the deadline.
+             *
+             * @param w Worker's index.
+             * @param deadline Time to stop at.
+             */
+            void
+            work ( uint w, SearchClock::time_point deadline )
+            {
+                Worker& worker = *_workers [ w ];
+                Deque&  deque  = *_deques [ w ];
+
+                while ( SearchClock::now() < deadline )
+                {
+                    Task task;
+
+                    if ( ! deque.pop ( task ) )
+                    {
+                        if ( steal ( w, task ) )
+                        {
+                            ++worker.steals;
+                        }
+                        else
+                        {
+                            Task own = { worker.best, worker.bestCost,
+                                         getRandomStrength ( worker ) };
+
+                            task = own;
+                        }
+                    }
+
+                    ++worker.tasks;
+
+                    load ( worker.current, *task.start );
+
+                    int64_t cost = task.cost + perturb ( worker, task.strength );
+
+                    cost += worker.search.run ( worker.current, deadline );
+
+                    if ( cost < worker.bestCost )
+                    {
+                        worker.best     = snapshot ( worker.current );
+                        worker.bestCost = cost;
+                    }
+
+                    if ( cost < task.cost && deque.size() < MAX_PENDING )
+                    {
+                        const Snapshot result   = snapshot ( worker.current );
+                        const uint     strength = std::max<uint> ( task.strength,
+                                                                   MIN_STRENGTH );
+
+                        Task mild     = { result, cost, strength };
+                        Task stronger = { result, cost,
+                                          std::min<uint> ( 2*strength, MAX_STRENGTH ) };
+
+                        deque.push ( stronger );
+                        deque.push ( mild );
+                    }
+                }
+            }
+
+            /**
+             * Steals the oldest task of the first other worker having one.
+             *
+             * @param w Thief's index.
+             * @param task Output.
+             * @return False if every other deque was empty.
+             */
+            bool
+            steal ( uint w, Task& task )
+            {
+                for ( uint k = 1 ; k < _numThreads ; ++k )
+                {
+                    if ( _deques [ ( w + k ) % _numThreads ]->steal ( task ) )
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * Applies up to strength random feasible shifts to candidate
+             * machines.
+             *
+             * @return Change of the objective.
+             */
+            int64_t
+            perturb ( Worker& worker, uint strength )
+            {
+                const uint numProcesses = _parameters.processes.size();
+
+                int64_t delta = 0;
+                uint    done  = 0;
+
+                for ( uint tries = 0 ; done < strength && tries < 4*strength ; ++tries )
+                {
+                    const uint         process    = worker.random() % numProcesses;
+                    const MachineRange candidates = _candidates.getCandidates ( process );
+
+                    if ( candidates.empty() )
+                    {
+                        continue;
+                    }
+
+                    const uint machine = candidates [ worker.random() % candidates.size() ];
+
+                    if ( machine != worker.current.getMachine ( process ) &&
+                         worker.oracle.canMove ( worker.current, process, machine ) )
+                    {
+                        delta += worker.evaluator.deltaShift ( worker.current,
+                                                               process, machine );
+                        worker.current.move ( process, machine );
+                        ++done;
+                    }
+                }
+
+                return delta;
+            }
+
+            /**
+             * @return Strength in [MIN_STRENGTH, MAX_STRENGTH].
+             */
+            static uint
+            getRandomStrength ( Worker& worker )
+            {
+                return MIN_STRENGTH +
+                       worker.random() % ( MAX_STRENGTH - MIN_STRENGTH + 1 );
+            }
+
+            /**
+             * @return Machine of every process of the assignment.
+             */
+            Snapshot
+            snapshot ( const Assignment& assignment ) const
+            {
+                boost::shared_ptr< std::vector<ushort> > machines
+                    ( new std::vector<ushort> ( _parameters.processes.size() ) );
+
+                for ( uint p = 0 ; p < machines->size() ; ++p )
+                {
+                    ( *machines ) [ p ] = assignment.getMachine ( p );
+                }
+
+                return machines;
+            }
+
+            /**
+             * Moves every process of the assignment to its machine in the
+             * snapshot. O(P*R).
+             */
+            static void
+            load ( Assignment& assignment, const std::vector<ushort>& machines )
+            {
+                for ( uint p = 0 ; p < machines.size() ; ++p )
+                {
+                    assignment.move ( p, machines [ p ] );
+                }
+            }
+
+        private:
+
+            const Parameters&       _parameters;
+            const CandidateLists&   _candidates;
+            const uint              _seed;
+            const uint              _numThreads;
+            bool                    _bestImprovement;
+            SearchStatistics        _statistics;
+            uint64_t                _numTasks;
+            uint64_t                _numSteals;
+            /** State of the current run. */
+            std::vector< boost::shared_ptr<Worker> > _workers;
+            std::vector< boost::shared_ptr<Deque> >  _deques;
+    };
+};
+
+#endif
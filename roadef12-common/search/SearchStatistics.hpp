@@ -0,0 +1,74 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_SEARCH_STATISTICS_HPP
+#define __roadef12_SEARCH_STATISTICS_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <chrono>
+#include <stdint.h>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Clock the search engines measure their wall-clock budget with.
+     */
+    typedef std::chrono::steady_clock SearchClock;
+
+    /**
+     * Counters of a search run.
+     *
+     * @author daniperez
+     */
+    struct SearchStatistics
+    {
+        /** Moves whose delta was computed. */
+        uint64_t evaluated;
+        /** Moves applied to the assignment. */
+        uint64_t applied;
+        /** Wall-clock time of the run. */
+        double   seconds;
+
+        /**
+         * Sets every counter to 0.
+         */
+        void
+        clear ()
+        {
+            evaluated = 0;
+            applied   = 0;
+            seconds   = 0;
+        }
+
+        /**
+         * @return Moves evaluated per second.
+         */
+        double
+        getEvaluationsPerSecond () const
+        {
+            return seconds > 0 ? evaluated / seconds : 0;
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,514 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_SIMULATED_ANNEALING_HPP
+#define __roadef12_SIMULATED_ANNEALING_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/SearchStatistics.hpp"
+#include "roadef12-common/search/XorShift.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <cmath>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Counters of one second of an annealing run.
+     */
+    struct AnnealingSecond
+    {
+        /** Temperature at the end of the second. */
+        double   temperature;
+        /** Moves sampled during the second. */
+        uint64_t evaluated;
+        /** Moves accepted (and feasible) during the second. */
+        uint64_t accepted;
+        /** Cost of the current assignment at the end of the second. */
+        int64_t  cost;
+    };
+
+    /**
+     * Simulated annealing over shift and swap moves. Each step samples a
+     * random process and one of its candidate machines, and either moves
+     * it there or swaps it with a random process of that machine. The
+     * move is accepted with the Metropolis rule from its O(R+B) delta
+     * (Evaluator), and only then checked for feasibility
+     * (FeasibilityOracle), so rejected moves cost no more than their
+     * delta.
+     *
+     * The temperature is tied to the wall clock, not to an iteration
+     * count: it goes down geometrically from the initial to the final
+     * temperature as the time between the start of run() and the deadline
+     * elapses, so the whole schedule fits in the -t budget whatever the
+     * speed of the machine. Both temperatures are calibrated from the
+     * median worsening delta of a sample of moves (the mean is dominated
+     * by a few huge deltas), accepted with probability 0.3 at the start
+     * and 1e-30 at the end.
+     *
+     * The inner loop doesn't allocate (the best assignment is copied to a
+     * preallocated buffer) and makes no virtual calls; the clock is read
+     * every CLOCK_PERIOD steps.
+     *
+     * @author daniperez
+     */
+    class SimulatedAnnealing
+    {
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the search.
+             * @param candidates Candidate machines, must outlive the search.
+             * @param seed Seed of the move sampling.
+             */
+            SimulatedAnnealing ( const Parameters& parameters,
+                                 const CandidateLists& candidates,
+                                 uint seed )
+                : _model ( parameters.compiled ),
+                  _evaluator ( parameters ),
+                  _oracle ( parameters ),
+                  _candidates ( candidates ),
+                  _random ( seed ),
+                  _best ( parameters.compiled.getNumProcesses() ),
+                  _initialTemperature ( 0 ),
+                  _finalTemperature ( 0 )
+            {
+                _statistics.clear ();
+            }
+
+            /**
+             * Anneals a feasible assignment until the deadline and leaves
+             * the best assignment found in it.
+             *
+             * @param assignment Feasible assignment, improved in place.
+             * @param deadline Time to stop at, the end of the schedule.
+             * @return Change of the objective, <= 0.
+             */
+            int64_t
+            run ( Assignment& assignment, SearchClock::time_point deadline )
+            {
+                const SearchClock::time_point start = SearchClock::now();
+
+                calibrate ( assignment );
+
+                const double budget
+                    = std::max ( 1e-3, std::chrono::duration<double>
+                                           ( deadline - start ).count() );
+                const double cooling = std::log ( _finalTemperature /
+                                                  _initialTemperature );
+
+                _timeline.clear ();
+                _timeline.reserve ( size_t ( budget ) + 2 );
+
+                double          elapsed    = 0;
+                double          nextSecond = 1;
+                AnnealingSecond second     = { _initialTemperature, 0, 0, 0 };
+
+                _cost        = 0;
+                _bestCost    = 0;
+                _saved       = false;
+                _temperature = _initialTemperature;
+                _threshold   = MAX_EXPONENT * _temperature;
+
+                for ( ; ; )
+                {
+                    for ( uint i = 0 ; i < CLOCK_PERIOD ; ++i )
+                    {
+                        second.accepted += step ( assignment );
+                    }
+
+                    second.evaluated += CLOCK_PERIOD;
+
+                    const SearchClock::time_point now = SearchClock::now();
+
+                    elapsed = std::chrono::duration<double> ( now - start ).count();
+
+                    const double fraction = std::min ( 1.0, elapsed / budget );
+
+                    _temperature = _initialTemperature * std::exp ( cooling * fraction );
+                    _threshold   = MAX_EXPONENT * _temperature;
+
+                    if ( elapsed >= nextSecond || now >= deadline )
+                    {
+                        second.temperature = _temperature;
+                        second.cost        = _cost;
+
+                        _statistics.evaluated += second.evaluated;
+                        _statistics.applied   += second.accepted;
+                        _timeline.push_back ( second );
+
+                        second.evaluated = 0;
+                        second.accepted  = 0;
+                        nextSecond       = std::floor ( elapsed ) + 1;
+                    }
+
+                    if ( now >= deadline )
+                    {
+                        break;
+                    }
+                }
+
+                // Back to the best assignment seen
+                if ( _cost != _bestCost )
+                {
+                    restore ( assignment );
+                }
+
+                _statistics.seconds += elapsed;
+
+                return _bestCost;
+            }
+
+            /**
+             * @name Counters.
+             */
+            ///@{
+            /**
+             * Moves evaluated and accepted, accumulated over the runs.
+             *
+             * @return Statistics.
+             */
+            const SearchStatistics&
+            getStatistics () const
+            {
+                return _statistics;
+            }
+
+            /**
+             * Counters of every second of the last run, the last entry
+             * covering the part of a second before the deadline.
+             *
+             * @return One entry per second.
+             */
+            const std::vector<AnnealingSecond>&
+            getTimeline () const
+            {
+                return _timeline;
+            }
+
+            /**
+             * @return Temperature the last run started at.
+             */
+            double
+            getInitialTemperature () const
+            {
+                return _initialTemperature;
+            }
+
+            /**
+             * @return Temperature the last run ended at.
+             */
+            double
+            getFinalTemperature () const
+            {
+                return _finalTemperature;
+            }
+            ///@}
+
+        protected:
+
+            /**
+             * Steps between clock reads, moves sampled to calibrate the
+             * temperatures, and exp() argument above which a move is
+             * rejected without computing it.
+             */
+            enum
+            {
+                CLOCK_PERIOD   = 256,
+                SAMPLE_SIZE    = 1000,
+                MAX_EXPONENT   = 30
+            };
+
+            /**
+             * Samples a move and applies it if the Metropolis rule accepts
+             * it and it is feasible.
+             *
+             * @param assignment Assignment.
+             * @return True if applied.
+             */
+            bool
+            step ( Assignment& assignment )
+            {
+                uint process, machine, other;
+                bool swap;
+
+                if ( ! sample ( assignment, process, machine, other, swap ) )
+                {
+                    return false;
+                }
+
+                if ( ! swap )
+                {
+                    const int64_t delta
+                        = _evaluator.deltaShift ( assignment, process, machine );
+
+                    if ( ! accept ( delta ) ||
+                         ! _oracle.canMove ( assignment, process, machine ) )
+                    {
+                        return false;
+                    }
+
+                    leave ( assignment, delta );
+                    assignment.move ( process, machine );
+
+                    return true;
+                }
+
+                const int64_t delta = _evaluator.deltaSwap ( assignment, process, other );
+
+                if ( ! accept ( delta ) )
+                {
+                    return false;
+                }
+
+                assignment.swap ( process, other );
+
+                if ( ! _oracle.keepsFeasibleAfterSwap ( assignment, process, other ) )
+                {
+                    assignment.swap ( process, other );
+
+                    return false;
+                }
+
+                // Undone to save the best assignment, rare
+                if ( delta > 0 && _cost == _bestCost && ! _saved )
+                {
+                    assignment.swap ( process, other );
+                    leave ( assignment, delta );
+                    assignment.swap ( process, other );
+                }
+                else
+                {
+                    leave ( assignment, delta );
+                }
+
+                return true;
+            }
+
+            /**
+             * Bookkeeping of an accepted move, called before applying it:
+             * copies the assignment to the best buffer if the move leaves
+             * a best assignment not saved yet.
+             *
+             * @param assignment Assignment, before the move.
+             * @param delta Delta of the move.
+             */
+            void
+            leave ( const Assignment& assignment, int64_t delta )
+            {
+                if ( delta > 0 && _cost == _bestCost && ! _saved )
+                {
+                    save ( assignment );
+                    _saved = true;
+                }
+
+                _cost += delta;
+
+                if ( _cost < _bestCost )
+                {
+                    _bestCost = _cost;
+                    _saved    = false;
+                }
+            }
+
+            /**
+             * Random process and candidate machine other than its own;
+             * every other step, a random process of that machine to swap
+             * with, that has the process' machine as candidate.
+             *
+             * @param assignment Assignment.
+             * @param process Output, process to move.
+             * @param machine Output, machine to move it to.
+             * @param other Output, process to swap with, if swap.
+             * @param swap Output, swap or shift.
+             * @return False if the draw gives no move.
+             */
+            bool
+            sample ( const Assignment& assignment,
+                     uint& process,
+                     uint& machine,
+                     uint& other,
+                     bool& swap )
+            {
+                const uint64_t bits = _random();
+
+                process = uint ( ( ( bits >> 32 ) * _model.getNumProcesses() ) >> 32 );
+
+                const MachineRange candidates = _candidates.getCandidates ( process );
+                const uint         from       = assignment.getMachine ( process );
+
+                if ( candidates.size() == 0 )
+                {
+                    return false;
+                }
+
+                machine = candidates [ _random.below ( candidates.size() ) ];
+                swap    = bits & 1;
+
+                if ( machine == from )
+                {
+                    return false;
+                }
+
+                if ( swap )
+                {
+                    const ProcessRange others
+                        = assignment.getProcessesPerMachine ( machine );
+
+                    if ( others.size() == 0 )
+                    {
+                        return false;
+                    }
+
+                    other = others [ _random.below ( others.size() ) ];
+
+                    const MachineRange reverse = _candidates.getCandidates ( other );
+
+                    return std::binary_search ( reverse.begin(), reverse.end(), from );
+                }
+
+                return true;
+            }
+
+            /**
+             * Metropolis rule.
+             *
+             * @param delta Delta of the move.
+             * @return True if accepted.
+             */
+            bool
+            accept ( int64_t delta )
+            {
+                return delta <= 0 ||
+                       ( delta < _threshold &&
+                         _random.uniform() < std::exp ( -delta / _temperature ) );
+            }
+
+            /**
+             * Sets the initial and final temperatures from the worsening
+             * deltas of a sample of moves (none applied). Runs once per
+             * run(), before the inner loop.
+             */
+            void
+            calibrate ( const Assignment& assignment )
+            {
+                std::vector<double> worsening;
+
+                for ( uint i = 0 ; i < SAMPLE_SIZE ; ++i )
+                {
+                    uint process, machine, other;
+                    bool swap;
+
+                    if ( ! sample ( assignment, process, machine, other, swap ) )
+                    {
+                        continue;
+                    }
+
+                    const int64_t delta
+                        = swap ? _evaluator.deltaSwap ( assignment, process, other ) :
+                                 _evaluator.deltaShift ( assignment, process, machine );
+
+                    if ( delta > 0 )
+                    {
+                        worsening.push_back ( delta );
+                    }
+                }
+
+                // Probabilities of accepting the median worsening move
+                const double initialAcceptance = 0.3;
+                const double finalAcceptance   = 1e-30;
+
+                double median = 1;
+
+                if ( ! worsening.empty() )
+                {
+                    std::nth_element ( worsening.begin(),
+                                       worsening.begin() + worsening.size()/2,
+                                       worsening.end() );
+
+                    median = worsening [ worsening.size()/2 ];
+                }
+
+                _initialTemperature = -median / std::log ( initialAcceptance );
+                _finalTemperature   = -median / std::log ( finalAcceptance );
+            }
+
+            /**
+             * Copies the assignment into the best buffer, as it was before
+             * the move just applied.
+             */
+            void
+            save ( const Assignment& assignment )
+            {
+                for ( uint p = 0 ; p < _best.size() ; ++p )
+                {
+                    _best [ p ] = assignment.getMachine ( p );
+                }
+            }
+
+            /**
+             * Moves every process back to its machine in the best buffer.
+             */
+            void
+            restore ( Assignment& assignment ) const
+            {
+                for ( uint p = 0 ; p < _best.size() ; ++p )
+                {
+                    assignment.move ( p, _best [ p ] );
+                }
+            }
+
+        private:
+
+            const CompiledModel&            _model;
+            Evaluator                       _evaluator;
+            FeasibilityOracle               _oracle;
+            const CandidateLists&           _candidates;
+            XorShift                        _random;
+            /** Machine of each process in the best assignment. */
+            std::vector<ushort>             _best;
+            double                          _initialTemperature;
+            double                          _finalTemperature;
+            double                          _temperature;
+            /** Deltas from which exp(-delta/T) is taken as 0. */
+            double                          _threshold;
+            /** Cost of the current and the best assignments, relative to the start. */
+            int64_t                         _cost;
+            int64_t                         _bestCost;
+            /** The best buffer holds an assignment of cost _bestCost. */
+            bool                            _saved;
+            SearchStatistics                _statistics;
+            std::vector<AnnealingSecond>    _timeline;
+    };
+};
+
+#endif
@@ -0,0 +1,228 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_SUBPROBLEM_SEARCH_HPP
+#define __roadef12_SUBPROBLEM_SEARCH_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/search/LocalSearch.hpp"
+#include "roadef12-common/search/SubproblemSolver.hpp"
+#include "roadef12-common/search/XorShift.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Local search down to a local optimum, then SubproblemSolver on
+     * groups of machines until the deadline, back to the local search
+     * after each group that improves.
+     *
+     * A group grows from a random machine by adding candidate machines
+     * (see CandidateLists) of random processes of the group, so that its
+     * processes can actually be exchanged among its machines.
+     *
+     * @author daniperez
+     */
+    class SubproblemSearch
+    {
+        public:
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the search.
+             * @param candidates Candidate machines, must outlive the search.
+             * @param seed Seed of the group choice and the local search.
+             * @param groupSize Machines per group.
+             * @param nodeLimit Node budget of each group.
+             */
+            SubproblemSearch ( const Parameters& parameters,
+                               const CandidateLists& candidates,
+                               uint seed,
+                               uint groupSize = 4,
+                               uint64_t nodeLimit = 50000 )
+                : _model ( parameters.compiled ),
+                  _candidates ( candidates ),
+                  _localSearch ( parameters, candidates, seed ),
+                  _solver ( parameters ),
+                  _random ( seed ),
+                  _groupSize ( std::min<uint> ( std::min<uint> ( groupSize,
+                                                                 SubproblemSolver::MAX_MACHINES ),
+                                                parameters.compiled.getNumMachines() ) ),
+                  _numGroups ( 0 ),
+                  _numImproved ( 0 ),
+                  _numOptimal ( 0 ),
+                  _numNodes ( 0 )
+            {
+                _solver.setNodeLimit ( nodeLimit );
+            }
+
+            /**
+             * Improves a feasible assignment until the deadline.
+             *
+             * @param assignment Feasible assignment, improved in place.
+             * @param deadline Time to stop at.
+             * @return Change of the objective, <= 0.
+             */
+            int64_t
+            run ( Assignment& assignment, SearchClock::time_point deadline )
+            {
+                int64_t total = _localSearch.run ( assignment, deadline );
+
+                std::vector<uint> group;
+
+                while ( SearchClock::now() < deadline )
+                {
+                    chooseGroup ( assignment, group );
+
+                    const int64_t delta
+                        = _solver.solve ( assignment, &group[0], group.size(), deadline );
+
+                    ++_numGroups;
+                    _numOptimal += _solver.isOptimal();
+                    _numNodes   += _solver.getNumNodes();
+
+                    if ( delta < 0 )
+                    {
+                        ++_numImproved;
+                        total += delta + _localSearch.run ( assignment, deadline );
+                    }
+                }
+
+                return total;
+            }
+
+            /**
+             * @name Counters, accumulated over the runs.
+             */
+            ///@{
+            /**
+             * @return Statistics of the local search.
+             */
+            const SearchStatistics&
+            getStatistics () const
+            {
+                return _localSearch.getStatistics();
+            }
+
+            /**
+             * @return Groups solved.
+             */
+            uint64_t
+            getNumGroups () const
+            {
+                return _numGroups;
+            }
+
+            /**
+             * @return Groups whose reassignment lowered the objective.
+             */
+            uint64_t
+            getNumImproved () const
+            {
+                return _numImproved;
+            }
+
+            /**
+             * @return Groups solved to optimality within the budget.
+             */
+            uint64_t
+            getNumOptimal () const
+            {
+                return _numOptimal;
+            }
+
+            /**
+             * @return Branch and bound nodes.
+             */
+            uint64_t
+            getNumNodes () const
+            {
+                return _numNodes;
+            }
+            ///@}
+
+        protected:
+
+            /**
+             * Random group of machines connected by candidate lists.
+             *
+             * @param assignment Assignment.
+             * @param group Output, the machines.
+             */
+            void
+            chooseGroup ( const Assignment& assignment, std::vector<uint>& group )
+            {
+                group.clear ();
+                group.push_back ( _random.below ( _model.getNumMachines() ) );
+
+                for ( uint tries = 0 ;
+                      group.size() < _groupSize && tries < 8*_groupSize ;
+                      ++tries )
+                {
+                    const ProcessRange processes
+                        = assignment.getProcessesPerMachine
+                              ( group [ _random.below ( group.size() ) ] );
+
+                    uint machine = _random.below ( _model.getNumMachines() );
+
+                    if ( processes.size() > 0 )
+                    {
+                        const MachineRange candidates = _candidates.getCandidates
+                            ( processes [ _random.below ( processes.size() ) ] );
+
+                        if ( candidates.size() > 0 )
+                        {
+                            machine = candidates [ _random.below ( candidates.size() ) ];
+                        }
+                    }
+
+                    if ( std::find ( group.begin(), group.end(), machine ) == group.end() )
+                    {
+                        group.push_back ( machine );
+                    }
+                }
+            }
+
+        private:
+
+            const CompiledModel&    _model;
+            const CandidateLists&   _candidates;
+            LocalSearch             _localSearch;
+            SubproblemSolver        _solver;
+            XorShift                _random;
+            const uint              _groupSize;
+            uint64_t                _numGroups;
+            uint64_t                _numImproved;
+            uint64_t                _numOptimal;
+            uint64_t                _numNodes;
+    };
+};
+
+#endif
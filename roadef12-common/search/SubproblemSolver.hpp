@@ -0,0 +1,937 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_SUBPROBLEM_SOLVER_HPP
+#define __roadef12_SUBPROBLEM_SOLVER_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/search/SearchStatistics.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Exact solver of the subproblem made of a few machines (3 to 8) and
+     * the processes on them: finds the cheapest reassignment of those
+     * processes among those machines, everything else fixed, by depth
+     * first branch and bound.
+     *
+     * Processes are branched on biggest first; for each one the current
+     * machine is tried first, then the others by increasing move cost.
+     * Capacity (transient usage included), conflicts, spread and the
+     * dependencies towards services out of the subproblem are checked
+     * as each process is placed; the dependencies among the subproblem's
+     * services, and the balance cost, at the leaves. A node is pruned when
+     * its lower bound reaches the best leaf so far (the current
+     * assignment to begin with). The bound adds up:
+     *   - the move costs of the placed processes, plus the cheapest
+     *     move cost of each process left,
+     *   - per resource, the load cost of the placed processes plus the
+     *     one of the remaining requirements poured into the room left
+     *     under the safety capacities of the machines (the exact minimum
+     *     if the processes could be split),
+     *   - the service move cost of the placed processes.
+     *
+     * The search stops at a node budget or a deadline; the best
+     * reassignment found is applied only if cheaper than the current one,
+     * and isOptimal() says if the search was complete.
+     *
+     * @author daniperez
+     */
+    class SubproblemSolver
+    {
+        public:
+
+            /**
+             * Maximum number of machines of a subproblem.
+             */
+            enum { MAX_MACHINES = 16 };
+
+            /**
+             * Constructor.
+             *
+             * @param parameters Parameters, must outlive the solver.
+             */
+            SubproblemSolver ( const Parameters& parameters )
+                : _parameters ( parameters ),
+                  _model ( parameters.compiled ),
+                  _services ( parameters.services ),
+                  _evaluator ( parameters ),
+                  _nodeLimit ( 1000000 ),
+                  _assignment ( NULL ),
+                  _machineIndex ( _model.getNumMachines(), NONE ),
+                  _serviceIndex ( _model.getNumServices(), NONE ),
+                  _numNodes ( 0 ),
+                  _optimal ( false )
+            {
+            }
+
+            /**
+             * Sets the node budget of each solve().
+             *
+             * @param limit Maximum number of nodes.
+             */
+            void
+            setNodeLimit ( uint64_t limit )
+            {
+                _nodeLimit = limit;
+            }
+
+            /**
+             * Reassigns optimally (within the budget) the processes of the
+             * given machines among them.
+             *
+             * @param assignment Feasible assignment, improved in place.
+             * @param machines Machines, all different.
+             * @param numMachines Number of machines, <= MAX_MACHINES.
+             * @param deadline Time to stop at.
+             * @return Change of the objective, <= 0.
+             */
+            int64_t
+            solve ( Assignment& assignment,
+                    const uint* machines,
+                    uint numMachines,
+                    SearchClock::time_point deadline )
+            {
+                Util::throwing_assert ( numMachines <= MAX_MACHINES );
+
+                _assignment = &assignment;
+                _deadline   = deadline;
+                _numNodes   = 0;
+                _aborted  = false;
+
+                setup ( assignment, machines, numMachines );
+
+                const int64_t current = _best;
+
+                branch ( 0 );
+
+                _optimal = ! _aborted;
+
+                // Apply the best leaf, if better than the current assignment
+                if ( _best < current )
+                {
+                    for ( uint j = 0 ; j < _processes.size() ; ++j )
+                    {
+                        assignment.move ( _processes [ j ],
+                                          _machines [ _bestAssignment [ j ] ] );
+                    }
+                }
+
+                cleanup ();
+
+                return _best - current;
+            }
+
+            /**
+             * @return Nodes explored by the last solve().
+             */
+            uint64_t
+            getNumNodes () const
+            {
+                return _numNodes;
+            }
+
+            /**
+             * @return True if the last solve() explored the whole tree.
+             */
+            bool
+            isOptimal () const
+            {
+                return _optimal;
+            }
+
+        protected:
+
+            /**
+             * No index, and nodes between deadline checks.
+             */
+            enum
+            {
+                NONE         = -1,
+                CLOCK_PERIOD = 1024
+            };
+
+            /**
+             * @name Setup.
+             */
+            ///@{
+            /**
+             * Builds the subproblem: processes, their order, the state of
+             * the machines without them, and the placement counters of
+             * their services without them.
+             */
+            void
+            setup ( const Assignment& assignment, const uint* machines, uint k )
+            {
+                const uint numResources = _model.getNumResources();
+                const int* transient    = _model.getTransientFlags ();
+
+                _k = k;
+                _machines.assign ( machines, machines + k );
+                _processes.clear ();
+                _locations.clear ();
+                _neighborhoods.clear ();
+                _machineLocation.resize ( k );
+                _machineNeighborhood.resize ( k );
+
+                for ( uint i = 0 ; i < k ; ++i )
+                {
+                    _machineIndex [ machines [ i ] ] = i;
+
+                    _machineLocation [ i ]
+                        = indexOf ( _locations, _model.getLocation ( machines [ i ] ) );
+                    _machineNeighborhood [ i ]
+                        = indexOf ( _neighborhoods, _model.getNeighborhood ( machines [ i ] ) );
+
+                    const ProcessRange processes
+                        = assignment.getProcessesPerMachine ( machines [ i ] );
+
+                    _processes.insert ( _processes.end(),
+                                        processes.begin(), processes.end() );
+                }
+
+                const uint n = _processes.size();
+
+                // Biggest first: share of the machines' capacity they take
+                _weight.assign ( _model.getNumProcesses(), 0 );
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    double total = 0;
+
+                    for ( uint i = 0 ; i < k ; ++i )
+                    {
+                        total += _model.getCapacities ( machines [ i ] ) [ r ];
+                    }
+
+                    for ( uint j = 0 ; j < n ; ++j )
+                    {
+                        _weight [ _processes [ j ] ]
+                            += _model.getRequirements ( _processes [ j ] ) [ r ] /
+                               std::max ( total, 1.0 );
+                    }
+                }
+
+                std::sort ( _processes.begin(), _processes.end(), ByWeight ( _weight ) );
+
+                // Machines without the processes: no load, the transient
+                // usage of the processes out of the subproblem
+                _load.assign ( k*numResources, 0 );
+                _kept.resize ( k*numResources );
+
+                for ( uint i = 0 ; i < k ; ++i )
+                {
+                    const uint* kept = assignment.getTransientUtilizations ( machines [ i ] );
+
+                    std::copy ( kept, kept + numResources, &_kept [ i*numResources ] );
+                }
+
+                // Services of the subproblem
+                _serviceOf.resize ( n );
+                _original.resize ( n );
+                _originOf.resize ( n );
+                _localServices.clear ();
+
+                for ( uint j = 0 ; j < n ; ++j )
+                {
+                    const uint process  = _processes [ j ];
+                    const uint service  = _model.getService ( process );
+                    const uint original = assignment.getOriginalMachine ( process );
+
+                    if ( _serviceIndex [ service ] == NONE )
+                    {
+                        _serviceIndex [ service ] = _localServices.size();
+                        _localServices.push_back ( service );
+                    }
+
+                    _serviceOf [ j ] = _serviceIndex [ service ];
+                    _original [ j ]  = original;
+                    _originOf [ j ]  = _machineIndex [ original ];
+
+                    // Its transient usage is counted again when placed
+                    if ( _originOf [ j ] != NONE && original != assignment.getMachine ( process ) )
+                    {
+                        for ( uint r = 0 ; r < numResources ; ++r )
+                        {
+                            _kept [ _originOf [ j ]*numResources + r ]
+                                -= transient [ r ] * _model.getRequirements ( process ) [ r ];
+                        }
+                    }
+                }
+
+                setupServices ( assignment );
+                setupCosts ( assignment );
+
+                _assigned.assign ( n, NONE );
+                _bestAssignment.resize ( n );
+
+                for ( uint j = 0 ; j < n ; ++j )
+                {
+                    _bestAssignment [ j ]
+                        = _machineIndex [ assignment.getMachine ( _processes [ j ] ) ];
+                }
+            }
+
+            /**
+             * Placement counters of the subproblem's services without its
+             * processes, and the members of each service.
+             */
+            void
+            setupServices ( const Assignment& assignment )
+            {
+                const uint numServices      = _localServices.size();
+                const uint numLocations     = _locations.size();
+                const uint numNeighborhoods = _neighborhoods.size();
+                const uint n                = _processes.size();
+
+                _inLocation.assign ( numServices*numLocations, 0 );
+                _inNeighborhood.assign ( numServices*numNeighborhoods, 0 );
+                _numLocations.assign ( numServices, 0 );
+                _moved.assign ( numServices, 0 );
+                _left.assign ( numServices, 0 );
+                _memberOffset.assign ( numServices + 1, 0 );
+                _members.resize ( n );
+
+                for ( uint s = 0 ; s < numServices ; ++s )
+                {
+                    const uint service = _localServices [ s ];
+
+                    _numLocations [ s ] = assignment.getNumLocationsPerService ( service );
+                    _moved [ s ]        = assignment.getNumMovedProcesses ( service );
+
+                    for ( uint l = 0 ; l < numLocations ; ++l )
+                    {
+                        _inLocation [ s*numLocations + l ]
+                            = assignment.getNumProcessesInLocation ( service, _locations [ l ] );
+                    }
+
+                    for ( uint b = 0 ; b < numNeighborhoods ; ++b )
+                    {
+                        _inNeighborhood [ s*numNeighborhoods + b ]
+                            = assignment.getNumProcessesInNeighborhood ( service,
+                                                                         _neighborhoods [ b ] );
+                    }
+                }
+
+                for ( uint j = 0 ; j < n ; ++j )
+                {
+                    const uint s       = _serviceOf [ j ];
+                    const uint process = _processes [ j ];
+                    const int  i       = _machineIndex [ assignment.getMachine ( process ) ];
+
+                    ++_left [ s ];
+                    ++_memberOffset [ s+1 ];
+
+                    _moved [ s ] -= ( assignment.getMachine ( process ) !=
+                                      assignment.getOriginalMachine ( process ) );
+
+                    --_inNeighborhood [ s*numNeighborhoods + _machineNeighborhood [ i ] ];
+
+                    if ( --_inLocation [ s*numLocations + _machineLocation [ i ] ] == 0 )
+                    {
+                        --_numLocations [ s ];
+                    }
+                }
+
+                std::partial_sum ( _memberOffset.begin(), _memberOffset.end(),
+                                   _memberOffset.begin() );
+
+                std::vector<int> next ( _memberOffset.begin(), _memberOffset.end() - 1 );
+
+                for ( uint j = 0 ; j < n ; ++j )
+                {
+                    _members [ next [ _serviceOf [ j ] ]++ ] = j;
+                }
+
+                // Highest number of moved processes out of the subproblem
+                _movedOut = 0;
+
+                for ( uint s = 0 ; s < _model.getNumServices() ; ++s )
+                {
+                    if ( _serviceIndex [ s ] == NONE )
+                    {
+                        _movedOut = std::max<int> ( _movedOut,
+                                                    assignment.getNumMovedProcesses ( s ) );
+                    }
+                }
+            }
+
+            /**
+             * Move costs, their suffix minima, the remaining requirements,
+             * the order the machines are tried in, and the cost of the
+             * current assignment of the subproblem (first incumbent).
+             */
+            void
+            setupCosts ( const Assignment& assignment )
+            {
+                const uint n            = _processes.size();
+                const uint k            = _k;
+                const uint numResources = _model.getNumResources();
+
+                _moveCost.resize ( n*k );
+                _order.resize ( n*k );
+                _minMoveLeft.assign ( n + 1, 0 );
+                _requirementsLeft.assign ( ( n + 1 )*numResources, 0 );
+
+                int64_t current = 0;
+
+                for ( int j = n - 1 ; j >= 0 ; --j )
+                {
+                    const uint process  = _processes [ j ];
+                    const uint original = assignment.getOriginalMachine ( process );
+                    const int* req      = _model.getRequirements ( process );
+                    int64_t    minimum  = std::numeric_limits<int64_t>::max();
+
+                    for ( uint i = 0 ; i < k ; ++i )
+                    {
+                        int64_t cost
+                            = int64_t ( _parameters.machines.getMovingCost ( original,
+                                                                             _machines [ i ] ) ) *
+                              _model.getMachineMoveCostWeight();
+
+                        if ( _machines [ i ] != original )
+                        {
+                            cost += int64_t ( _model.getPMC ( process ) ) *
+                                    _model.getProcessMoveCostWeight();
+                        }
+
+                        _moveCost [ j*k + i ] = cost;
+                        _order [ j*k + i ]    = i;
+                        minimum               = std::min ( minimum, cost );
+                    }
+
+                    // Current machine first, then by move cost
+                    uint* const order   = &_order [ j*k ];
+                    const uint  machine = _machineIndex [ assignment.getMachine ( process ) ];
+
+                    std::sort ( order, order + k, ByCost ( &_moveCost [ j*k ] ) );
+
+                    uint* const first = std::find ( order, order + k, machine );
+
+                    std::rotate ( order, first, first + 1 );
+
+                    current += _moveCost [ j*k + machine ];
+
+                    _minMoveLeft [ j ] = _minMoveLeft [ j+1 ] + minimum;
+
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        _requirementsLeft [ j*numResources + r ]
+                            = _requirementsLeft [ ( j+1 )*numResources + r ] + req [ r ];
+                    }
+                }
+
+                for ( uint i = 0 ; i < k ; ++i )
+                {
+                    const uint* load = assignment.getUtilizations ( _machines [ i ] );
+
+                    current += _evaluator.getLoadCost ( _machines [ i ], load ) +
+                               _evaluator.getBalanceCost ( _machines [ i ], load );
+                }
+
+                current += int64_t ( assignment.getServiceMoveTracker().getMax() ) *
+                           _model.getServiceMoveCostWeight();
+
+                _best     = current;
+                _moveSum  = 0;
+            }
+
+            /**
+             * Resets the global index maps.
+             */
+            void
+            cleanup ()
+            {
+                for ( uint i = 0 ; i < _k ; ++i )
+                {
+                    _machineIndex [ _machines [ i ] ] = NONE;
+                }
+
+                for ( uint s = 0 ; s < _localServices.size() ; ++s )
+                {
+                    _serviceIndex [ _localServices [ s ] ] = NONE;
+                }
+            }
+            ///@}
+
+            /**
+             * @name Search.
+             */
+            ///@{
+            /**
+             * Places process j and the following ones.
+             */
+            void
+            branch ( uint j )
+            {
+                if ( _aborted )
+                {
+                    return;
+                }
+
+                if ( ++_numNodes % CLOCK_PERIOD == 0 && SearchClock::now() >= _deadline )
+                {
+                    _aborted = true;
+                }
+
+                if ( _numNodes >= _nodeLimit )
+                {
+                    _aborted = true;
+                }
+
+                if ( j == _processes.size() )
+                {
+                    leaf ();
+                    return;
+                }
+
+                if ( getLowerBound ( j ) >= _best )
+                {
+                    return;
+                }
+
+                for ( uint o = 0 ; o < _k && ! _aborted ; ++o )
+                {
+                    const uint i = _order [ j*_k + o ];
+
+                    if ( place ( j, i ) )
+                    {
+                        branch ( j+1 );
+                    }
+
+                    unplace ( j, i );
+                }
+            }
+
+            /**
+             * Places process j on machine i and checks the constraints
+             * that can be checked before the leaves. Undo with unplace()
+             * whatever it returns.
+             *
+             * @return False if a constraint is violated.
+             */
+            bool
+            place ( uint j, uint i )
+            {
+                const uint numResources = _model.getNumResources();
+                const uint process      = _processes [ j ];
+                const uint s            = _serviceOf [ j ];
+                const int* req          = _model.getRequirements ( process );
+                const int* transient    = _model.getTransientFlags ();
+                const int  origin       = _originOf [ j ];
+                uint*      load         = &_load [ i*numResources ];
+                bool       legal        = true;
+
+                _assigned [ j ] = i;
+                _moveSum       += _moveCost [ j*_k + i ];
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    load [ r ] += req [ r ];
+                }
+
+                if ( origin != NONE && origin != int ( i ) )
+                {
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        _kept [ origin*numResources + r ] += transient [ r ] * req [ r ];
+                    }
+
+                    legal = fits ( origin );
+                }
+
+                legal = legal && fits ( i );
+
+                _moved [ s ] += ( _machines [ i ] != _original [ j ] );
+                --_left [ s ];
+
+                ++_inNeighborhood [ s*_neighborhoods.size() + _machineNeighborhood [ i ] ];
+
+                if ( _inLocation [ s*_locations.size() + _machineLocation [ i ] ]++ == 0 )
+                {
+                    ++_numLocations [ s ];
+                }
+
+                if ( ! legal )
+                {
+                    return false;
+                }
+
+                // Conflict
+                for ( int m = _memberOffset [ s ] ; m < _memberOffset [ s+1 ] ; ++m )
+                {
+                    const uint other = _members [ m ];
+
+                    if ( other != j && _assigned [ other ] == int ( i ) )
+                    {
+                        return false;
+                    }
+                }
+
+                // Spread: each process left can add one location at most
+                if ( _numLocations [ s ] + _left [ s ] <
+                     _services.getMinSpread ( _localServices [ s ] ) )
+                {
+                    return false;
+                }
+
+                // Dependencies out of the subproblem can't change
+                const ValuesView dependencies
+                    = _services.getDependencies ( _localServices [ s ] );
+
+                for ( uint d = 0 ; d < dependencies.size() ; ++d )
+                {
+                    if ( _serviceIndex [ dependencies [ d ] ] == NONE &&
+                         getInNeighborhood ( dependencies [ d ],
+                                             _machineNeighborhood [ i ] ) == 0 )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Undoes place().
+             */
+            void
+            unplace ( uint j, uint i )
+            {
+                const uint numResources = _model.getNumResources();
+                const uint process      = _processes [ j ];
+                const uint s            = _serviceOf [ j ];
+                const int* req          = _model.getRequirements ( process );
+                const int* transient    = _model.getTransientFlags ();
+                const int  origin       = _originOf [ j ];
+                uint*      load         = &_load [ i*numResources ];
+
+                _assigned [ j ] = NONE;
+                _moveSum       -= _moveCost [ j*_k + i ];
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    load [ r ] -= req [ r ];
+                }
+
+                if ( origin != NONE && origin != int ( i ) )
+                {
+                    for ( uint r = 0 ; r < numResources ; ++r )
+                    {
+                        _kept [ origin*numResources + r ] -= transient [ r ] * req [ r ];
+                    }
+                }
+
+                _moved [ s ] -= ( _machines [ i ] != _original [ j ] );
+                ++_left [ s ];
+
+                --_inNeighborhood [ s*_neighborhoods.size() + _machineNeighborhood [ i ] ];
+
+                if ( --_inLocation [ s*_locations.size() + _machineLocation [ i ] ] == 0 )
+                {
+                    --_numLocations [ s ];
+                }
+            }
+
+            /**
+             * Checks the dependencies in the subproblem's neighborhoods
+             * and records the leaf if it is the best one.
+             */
+            void
+            leaf ()
+            {
+                for ( uint b = 0 ; b < _neighborhoods.size() ; ++b )
+                {
+                    for ( uint s = 0 ; s < _localServices.size() ; ++s )
+                    {
+                        const uint service = _localServices [ s ];
+
+                        if ( _inNeighborhood [ s*_neighborhoods.size() + b ] > 0 )
+                        {
+                            const ValuesView dependencies
+                                = _services.getDependencies ( service );
+
+                            for ( uint d = 0 ; d < dependencies.size() ; ++d )
+                            {
+                                if ( getInNeighborhood ( dependencies [ d ], b ) == 0 )
+                                {
+                                    return;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            const ValuesView dependents
+                                = _services.getDependents ( service );
+
+                            for ( uint d = 0 ; d < dependents.size() ; ++d )
+                            {
+                                if ( getInNeighborhood ( dependents [ d ], b ) > 0 )
+                                {
+                                    return;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                int64_t cost = _moveSum + getServiceMoveCost ();
+
+                for ( uint i = 0 ; i < _k ; ++i )
+                {
+                    const uint* load = &_load [ i*_model.getNumResources() ];
+
+                    cost += _evaluator.getLoadCost ( _machines [ i ], load ) +
+                            _evaluator.getBalanceCost ( _machines [ i ], load );
+                }
+
+                if ( cost < _best )
+                {
+                    _best = cost;
+                    std::copy ( _assigned.begin(), _assigned.end(),
+                                _bestAssignment.begin() );
+                }
+            }
+
+            /**
+             * Lower bound of the leaves under the node where processes
+             * [0, j) are placed (see the class' description). Also 'infinite'
+             * if the remaining requirements exceed the room left.
+             */
+            int64_t
+            getLowerBound ( uint j ) const
+            {
+                const uint numResources = _model.getNumResources();
+                const int* weights      = _model.getLoadCostWeights ();
+
+                int64_t bound = _moveSum + _minMoveLeft [ j ] + getServiceMoveCost ();
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    const int64_t left  = _requirementsLeft [ j*numResources + r ];
+                    int64_t       over  = 0;
+                    int64_t       under = 0;
+                    int64_t       room  = 0;
+
+                    for ( uint i = 0 ; i < _k ; ++i )
+                    {
+                        const int64_t load     = _load [ i*numResources + r ];
+                        const int64_t safety   = _model.getSafetyCapacities ( _machines [ i ] ) [ r ];
+                        const int64_t capacity = _model.getCapacities ( _machines [ i ] ) [ r ];
+
+                        over  += std::max<int64_t> ( load - safety, 0 );
+                        under += std::max<int64_t> ( safety - load, 0 );
+                        room  += capacity - load - _kept [ i*numResources + r ];
+                    }
+
+                    if ( left > room )
+                    {
+                        return std::numeric_limits<int64_t>::max();
+                    }
+
+                    bound += weights [ r ] * ( over + std::max<int64_t> ( left - under, 0 ) );
+                }
+
+                return bound;
+            }
+            ///@}
+
+            /**
+             * Says if the load plus the transient usage of machine i fit
+             * its capacities.
+             */
+            bool
+            fits ( uint i ) const
+            {
+                const uint  numResources = _model.getNumResources();
+                const int*  capacities   = _model.getCapacities ( _machines [ i ] );
+                const uint* load         = &_load [ i*numResources ];
+                const uint* kept         = &_kept [ i*numResources ];
+
+                for ( uint r = 0 ; r < numResources ; ++r )
+                {
+                    if ( load [ r ] + kept [ r ] > uint ( capacities [ r ] ) )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * Processes of a service in a neighborhood of the subproblem.
+             *
+             * @param service Service's id.
+             * @param b Neighborhood's index in the subproblem.
+             */
+            uint
+            getInNeighborhood ( uint service, uint b ) const
+            {
+                const int s = _serviceIndex [ service ];
+
+                return s == NONE ? _assignment->getNumProcessesInNeighborhood
+                                       ( service, _neighborhoods [ b ] )
+                                 : _inNeighborhood [ s*_neighborhoods.size() + b ];
+            }
+
+            /**
+             * Weighted service move cost of the placed processes.
+             */
+            int64_t
+            getServiceMoveCost () const
+            {
+                int maximum = _movedOut;
+
+                for ( uint s = 0 ; s < _moved.size() ; ++s )
+                {
+                    maximum = std::max ( maximum, _moved [ s ] );
+                }
+
+                return int64_t ( maximum ) * _model.getServiceMoveCostWeight();
+            }
+
+            /**
+             * Index of the value in the vector, added if missing.
+             */
+            static uint
+            indexOf ( std::vector<uint>& values, uint value )
+            {
+                const std::vector<uint>::iterator it
+                    = std::find ( values.begin(), values.end(), value );
+
+                if ( it != values.end() )
+                {
+                    return it - values.begin();
+                }
+
+                values.push_back ( value );
+
+                return values.size() - 1;
+            }
+
+            /**
+             * Orders processes by decreasing weight.
+             */
+            struct ByWeight
+            {
+                ByWeight ( const std::vector<double>& weight ) : _weight ( weight ) {}
+
+                bool
+                operator() ( uint a, uint b ) const
+                {
+                    return _weight [ a ] > _weight [ b ];
+                }
+
+                const std::vector<double>& _weight;
+            };
+
+            /**
+             * Orders machine indices by increasing cost.
+             */
+            struct ByCost
+            {
+                ByCost ( const int64_t* cost ) : _cost ( cost ) {}
+
+                bool
+                operator() ( uint a, uint b ) const
+                {
+                    return _cost [ a ] < _cost [ b ];
+                }
+
+                const int64_t* _cost;
+            };
+
+        private:
+
+            const Parameters&       _parameters;
+            const CompiledModel&    _model;
+            const Services&         _services;
+            Evaluator               _evaluator;
+            uint64_t                _nodeLimit;
+            const Assignment*       _assignment;
+            SearchClock::time_point _deadline;
+
+            /** Index in the subproblem of each machine and service, or NONE. */
+            std::vector<int>        _machineIndex;
+            std::vector<int>        _serviceIndex;
+
+            /** Subproblem: machines, processes (branching order), services. */
+            uint                    _k;
+            std::vector<uint>       _machines;
+            std::vector<uint>       _processes;
+            std::vector<uint>       _localServices;
+            /** Locations and neighborhoods of the machines, and their index. */
+            std::vector<uint>       _locations;
+            std::vector<uint>       _neighborhoods;
+            std::vector<uint>       _machineLocation;
+            std::vector<uint>       _machineNeighborhood;
+            std::vector<double>     _weight;
+
+            /** Per process: service index, original machine, its index (or NONE). */
+            std::vector<uint>       _serviceOf;
+            std::vector<uint>       _original;
+            std::vector<int>        _originOf;
+            /** Processes of each service: [_memberOffset[s], [s+1]). */
+            std::vector<uint>       _members;
+            std::vector<int>        _memberOffset;
+            /** Move cost of each process on each machine, [n][k]. */
+            std::vector<int64_t>    _moveCost;
+            /** Machines in the order they are tried, [n][k]. */
+            std::vector<uint>       _order;
+            /** Cheapest move costs of processes [j, n), requirements of [j, n). */
+            std::vector<int64_t>    _minMoveLeft;
+            std::vector<int64_t>    _requirementsLeft;
+
+            /** State: loads and transient usage [k][R], placement per service. */
+            std::vector<uint>       _load;
+            std::vector<uint>       _kept;
+            std::vector<int>        _inLocation;
+            std::vector<int>        _inNeighborhood;
+            std::vector<int>        _numLocations;
+            std::vector<int>        _moved;
+            std::vector<int>        _left;
+            int                     _movedOut;
+            std::vector<int>        _assigned;
+            int64_t                 _moveSum;
+
+            /** Best leaf. */
+            int64_t                 _best;
+            std::vector<int>        _bestAssignment;
+
+            uint64_t                _numNodes;
+            bool                    _aborted;
+            bool                    _optimal;
+    };
+};
+
+#endif
@@ -0,0 +1,122 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_WORK_STEALING_DEQUE_HPP
+#define __roadef12_WORK_STEALING_DEQUE_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <deque>
+#include <mutex>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Task deque of one worker. The owner pushes and pops at the back
+     * (latest task first, its data is still in cache), idle workers steal
+     * from the front (oldest task first). Tasks are coarse (a whole
+     * local search each), so a mutex per deque is never contended enough
+     * to matter.
+     *
+     * @author daniperez
+     */
+    template <typename Task>
+    class WorkStealingDeque
+    {
+        public:
+
+            /**
+             * Adds a task. Owner only.
+             *
+             * @param task Task.
+             */
+            void
+            push ( const Task& task )
+            {
+                std::lock_guard<std::mutex> lock ( _mutex );
+
+                _tasks.push_back ( task );
+            }
+
+            /**
+             * Takes the latest task. Owner only.
+             *
+             * @param task Output.
+             * @return False if there was none.
+             */
+            bool
+            pop ( Task& task )
+            {
+                std::lock_guard<std::mutex> lock ( _mutex );
+
+                if ( _tasks.empty() )
+                {
+                    return false;
+                }
+
+                task = _tasks.back();
+                _tasks.pop_back();
+
+                return true;
+            }
+
+            /**
+             * Takes the oldest task. Any thread.
+             *
+             * @param task Output.
+             * @return False if there was none.
+             */
+            bool
+            steal ( Task& task )
+            {
+                std::lock_guard<std::mutex> lock ( _mutex );
+
+                if ( _tasks.empty() )
+                {
+                    return false;
+                }
+
+                task = _tasks.front();
+                _tasks.pop_front();
+
+                return true;
+            }
+
+            /**
+             * @return Number of tasks waiting.
+             */
+            size_t
+            size () const
+            {
+                std::lock_guard<std::mutex> lock ( _mutex );
+
+                return _tasks.size();
+            }
+
+        private:
+
+            mutable std::mutex _mutex;
+            std::deque<Task>   _tasks;
+    };
+};
+
+#endif
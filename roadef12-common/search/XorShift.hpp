@@ -0,0 +1,108 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_XOR_SHIFT_HPP
+#define __roadef12_XOR_SHIFT_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <stdint.h>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * xorshift64* generator: a few shifts and a multiplication per
+     * number, for the inner loops that sample millions of moves per
+     * second (std::mt19937 is several times slower). Meets the uniform
+     * random bit generator requirements, so it works with the standard
+     * algorithms too.
+     *
+     * @author daniperez
+     */
+    class XorShift
+    {
+        public:
+
+            typedef uint64_t result_type;
+
+            /**
+             * Constructor. Any seed, 0 included, gives a valid state.
+             *
+             * @param seed Seed.
+             */
+            explicit XorShift ( uint64_t seed )
+            {
+                // splitmix64 step, spreads consecutive seeds apart
+                uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+
+                z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+                z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+                z =   z ^ ( z >> 31 );
+
+                _state = z ? z : 1;
+            }
+
+            /**
+             * @return Next 64 random bits.
+             */
+            result_type
+            operator() ()
+            {
+                _state ^= _state >> 12;
+                _state ^= _state << 25;
+                _state ^= _state >> 27;
+
+                return _state * 0x2545F4914F6CDD1Dull;
+            }
+
+            /**
+             * Uniform integer in [0, n), by multiplication instead of
+             * modulo.
+             *
+             * @param n Bound, > 0.
+             * @return Random integer.
+             */
+            uint32_t
+            below ( uint32_t n )
+            {
+                return uint32_t ( ( ( (*this)() >> 32 ) * n ) >> 32 );
+            }
+
+            /**
+             * @return Uniform real in [0, 1).
+             */
+            double
+            uniform ()
+            {
+                return ( (*this)() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+            }
+
+            static result_type min () { return 0; }
+            static result_type max () { return ~result_type ( 0 ); }
+
+        private:
+
+            uint64_t _state;
+    };
+};
+
+#endif
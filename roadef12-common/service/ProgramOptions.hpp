@@ -149,6 +149,17 @@ namespace ROADEF12COMMON
                     throw ROADEF12COMMON::InvalidParametersException
                             ( "-p, -i and -o parameters are mandatory" );
                 }
+
+                if ( input.search != "none" &&
+                     input.search != "local" &&
+                     input.search != "multistart" &&
+                     input.search != "lns" &&
+                     input.search != "annealing" &&
+                     input.search != "exact" )
+                {
+                    throw ROADEF12COMMON::InvalidParametersException
+                            ( "--search must be none, local, multistart, lns, annealing or exact" );
+                }
             }
 
             return input;
@@ -254,6 +265,21 @@ namespace ROADEF12COMMON
                   boost::program_options::value<bool>( &input.nullCopy )
                     ->zero_tokens()->default_value(false),
                   "No optimization, copies input"
+                )
+                ( "search",
+                  boost::program_options::value<std::string>( &input.search )
+                    ->default_value("none"),
+                  "Search to run: none (copies input), local, multistart, lns, annealing or exact"
+                )
+                ( "best-improvement",
+                  boost::program_options::value<bool>( &input.bestImprovement )
+                    ->zero_tokens()->default_value(false),
+                  "Local search applies the best move instead of the first"
+                )
+                ( "threads",
+                  boost::program_options::value<unsigned int>( &input.threads )
+                    ->default_value(0),
+                  "Number of threads, 0 for all the hardware threads"
                 );
             
             // Wrap-up
@@ -32,7 +32,15 @@
 #include "roadef12-common/service/ServiceExceptions.hpp"
 #include "roadef12-common/objects/Parameters.hpp"
 #include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/search/LocalSearch.hpp"
+#include "roadef12-common/search/MultiStartSearch.hpp"
+#include "roadef12-common/search/LargeNeighborhoodSearch.hpp"
+#include "roadef12-common/search/SimulatedAnnealing.hpp"
+#include "roadef12-common/search/SubproblemSearch.hpp"
 #include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/commands/CompiledInstance.hpp"
 ///////////////////////////////////////////////////////////////////////////
 // STD
 #include <vector>
@@ -88,6 +96,24 @@ namespace ROADEF12COMMON
          * produced (-u switch).
          */
         bool nullNull;
+
+        /**
+         * Search to run: "none" (input solution copied), "local",
+         * "multistart", "lns", "annealing" or "exact" (--search switch).
+         */
+        std::string search;
+
+        /**
+         * Local search applies the best move of the neighborhood instead
+         * of the first improving one (--best-improvement switch).
+         */
+        bool bestImprovement;
+
+        /**
+         * Number of threads, 0 for all the hardware threads (--threads
+         * switch).
+         */
+        unsigned int threads;
     };    
     
     /**
@@ -108,13 +134,15 @@ namespace ROADEF12COMMON
              */
             Service ( const ROADEF12COMMON::ServiceInput& input )
               throw ( ROADEF12COMMON::IOException, ROADEF12COMMON::ParseException )
-                : options  ( parseInput ( input ) ),
-                  params   ( _parametersArray ),
+                : _start   ( SearchClock::now() ),
+                  options  ( parseInput ( input ) ),
+                  params   ( _instance->values(), _instance->getMoveCosts() ),
                   firstAssignment
                   (
                       input.referenceSolution.c_str(),
                       params
-                  )
+                  ),
+                  candidates ( params, input.threads )
             {
             }
             
@@ -144,6 +172,10 @@ namespace ROADEF12COMMON
                           << " machines=" << params.machines.size()
                           << " resources=" << params.resources.size()
                           << std::endl;
+                std::cout << "endcandidates=" << candidates.getBuildTime() << "ms"
+                          << std::endl;
+                std::cout << "Number of candidates=" << candidates.size()
+                          << std::endl;
 
                 if ( options.nullCopy )
                 {
@@ -155,7 +187,7 @@ namespace ROADEF12COMMON
                 }
                 else
                 {
-                    firstAssignment.write ( options.solution.c_str() );
+                    search ().write ( options.solution.c_str() );
                 }
             }
 
@@ -256,11 +288,175 @@ namespace ROADEF12COMMON
                 return output.str();
             }
 
-        protected:    
+        protected:
+
+            /**
+             * Runs the search selected by the options (see
+             * ServiceInput::search) from the first assignment, until
+             * the deadline.
+             *
+             * @return Best assignment found.
+             */
+            Assignment
+            search () const
+            {
+                Assignment best ( firstAssignment );
+
+                if ( options.search == "local" )
+                {
+                    LocalSearch engine ( params, candidates, options.seed );
+
+                    engine.setBestImprovement ( options.bestImprovement );
+                    runSearch ( engine, best );
+                }
+                else if ( options.search == "multistart" )
+                {
+                    MultiStartSearch engine ( params, candidates,
+                                              options.seed, options.threads );
+
+                    engine.setBestImprovement ( options.bestImprovement );
+                    runSearch ( engine, best );
+                }
+                else if ( options.search == "lns" )
+                {
+                    LargeNeighborhoodSearch engine ( params, candidates, options.seed );
+
+                    runSearch ( engine, best );
+                }
+                else if ( options.search == "annealing" )
+                {
+                    SimulatedAnnealing engine ( params, candidates, options.seed );
+
+                    runSearch ( engine, best );
+                }
+                else if ( options.search == "exact" )
+                {
+                    SubproblemSearch engine ( params, candidates, options.seed );
+
+                    runSearch ( engine, best );
+                }
+
+                return best;
+            }
+
+            /**
+             * Runs the search engine on the assignment until the deadline
+             * and prints its outcome and counters.
+             *
+             * @param engine Search engine, with run ( Assignment&, deadline )
+             *        and getStatistics ().
+             * @param best Assignment to improve, in place.
+             */
+            template <typename Engine>
+            void
+            runSearch ( Engine& engine, Assignment& best ) const
+            {
+                Evaluator evaluator ( params );
+
+                const int64_t initial = evaluator.evaluate ( best ).total();
+                const int64_t delta   = engine.run ( best, getDeadline() );
+
+                report ( initial, delta, engine.getStatistics() );
+                printCounters ( engine, initial );
+            }
+
+            /**
+             * @name Counters specific to each search engine.
+             *
+             * @param engine Search engine, after run ().
+             * @param initial Cost of the first assignment.
+             */
+            ///@{
+            static void
+            printCounters ( const LocalSearch&, int64_t )
+            {
+            }
+
+            static void
+            printCounters ( const MultiStartSearch& engine, int64_t )
+            {
+                std::cout << "threads=" << engine.getNumThreads()
+                          << " tasks=" << engine.getNumTasks()
+                          << " steals=" << engine.getNumSteals()
+                          << std::endl;
+            }
+
+            static void
+            printCounters ( const LargeNeighborhoodSearch& engine, int64_t )
+            {
+                std::cout << "iterations=" << engine.getNumIterations()
+                          << " improvements=" << engine.getNumImprovements()
+                          << " failed repairs=" << engine.getNumFailedRepairs()
+                          << " destroy size=" << engine.getDestroySize()
+                          << std::endl;
+            }
+
+            static void
+            printCounters ( const SimulatedAnnealing& engine, int64_t initial )
+            {
+                const std::vector<AnnealingSecond>& timeline = engine.getTimeline();
+
+                for ( uint s = 0 ; s < timeline.size() ; ++s )
+                {
+                    std::cout << "second=" << s + 1
+                              << " temperature=" << timeline [ s ].temperature
+                              << " moves/s=" << timeline [ s ].evaluated
+                              << " accepted/s=" << timeline [ s ].accepted
+                              << " cost=" << initial + timeline [ s ].cost
+                              << std::endl;
+                }
+            }
+
+            static void
+            printCounters ( const SubproblemSearch& engine, int64_t )
+            {
+                std::cout << "groups=" << engine.getNumGroups()
+                          << " improved=" << engine.getNumImproved()
+                          << " optimal=" << engine.getNumOptimal()
+                          << " nodes=" << engine.getNumNodes()
+                          << std::endl;
+            }
+            ///@}
+
+            /**
+             * Prints the outcome of a search.
+             *
+             * @param initial Cost of the first assignment.
+             * @param delta Change of the cost.
+             * @param statistics Counters of the search.
+             */
+            static void
+            report ( int64_t initial,
+                     int64_t delta,
+                     const SearchStatistics& statistics )
+            {
+                std::cout << "cost=" << initial << " -> " << initial + delta
+                          << std::endl;
+                std::cout << "moves evaluated=" << statistics.evaluated
+                          << " applied=" << statistics.applied
+                          << " moves/s="
+                          << uint64_t ( statistics.getEvaluationsPerSecond() )
+                          << std::endl;
+            }
+
+            /**
+             * Time the search must stop at: the -t budget, counted from
+             * the construction of the service, minus 5% kept for writing
+             * the solution.
+             *
+             * @return Deadline.
+             */
+            SearchClock::time_point
+            getDeadline () const
+            {
+                return _start + std::chrono::milliseconds
+                                    ( uint64_t ( options.secondsTimeLimit ) * 950 );
+            }
                      
             /**
-             * Parses the model parameters.
-             * Returns input parameter for convenience.
+             * Parses the model parameters, or maps them from the
+             * compiled instance if there is an up-to-date one (see
+             * CompiledInstance). Returns input parameter for convenience.
              * 
              * @param input Input to be parsed.
              * @throw IOException if the input files cannot be read.
@@ -270,7 +466,10 @@ namespace ROADEF12COMMON
             parseInput ( const ServiceInput& input )
             throw ( ROADEF12COMMON::IOException, ROADEF12COMMON::ParseException )
             {
-                FileParser::parseVector ( input.parameters.c_str(), _parametersArray );
+                _instance.reset
+                (
+                    new CompiledInstance ( input.parameters.c_str() )
+                );
                 
                 return input;
             }
@@ -278,7 +477,12 @@ namespace ROADEF12COMMON
         private:
              
              // WARNING: this must be declared before options
-             std::vector<int>                   _parametersArray;
+             boost::shared_ptr<CompiledInstance> _instance;
+
+             /**
+              * Construction time, the -t budget counts from it.
+              */
+             const SearchClock::time_point       _start;
              
         public:
 
@@ -299,6 +503,11 @@ namespace ROADEF12COMMON
              * First process to machine  assignment.
              */
             const Assignment                    firstAssignment;
+
+            /**
+             * Machines that may host each process (see CandidateLists).
+             */
+            const CandidateLists                candidates;
     };
 
 };
@@ -0,0 +1,133 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_common_ALIGNED_ALLOCATOR_HPP
+#define __roadef12_common_ALIGNED_ALLOCATOR_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * STL allocator returning memory aligned to Alignment bytes (a cache
+     * line by default), so that rows of the hot arrays start on a cache
+     * line boundary.
+     *
+     * @author daniperez
+     */
+    template <typename T, size_t Alignment = 64>
+    class AlignedAllocator
+    {
+        public:
+
+            /** Allocated type. */
+            typedef T value_type;
+
+            /**
+             * Rebinds the allocator to another type.
+             */
+            template <typename U>
+            struct rebind
+            {
+                /** Rebound allocator. */
+                typedef AlignedAllocator<U, Alignment> other;
+            };
+
+            /**
+             * Constructor.
+             */
+            AlignedAllocator ()
+            {
+            }
+
+            /**
+             * Converting constructor.
+             */
+            template <typename U>
+            AlignedAllocator ( const AlignedAllocator<U, Alignment>& )
+            {
+            }
+
+            /**
+             * Allocates room for n objects.
+             *
+             * @param n Number of objects.
+             * @return Aligned memory.
+             * @throw std::bad_alloc if there is no memory left.
+             */
+            T*
+            allocate ( size_t n )
+            {
+                void* memory = NULL;
+
+                if ( ::posix_memalign ( &memory, Alignment, n*sizeof(T) ) != 0 )
+                {
+                    throw std::bad_alloc();
+                }
+
+                return static_cast<T*> ( memory );
+            }
+
+            /**
+             * Frees memory returned by allocate.
+             *
+             * @param p Memory to free.
+             */
+            void
+            deallocate ( T* p, size_t )
+            {
+                ::free ( p );
+            }
+    };
+
+    /**
+     * All AlignedAllocator's are interchangeable.
+     */
+    template <typename T, typename U, size_t A>
+    bool
+    operator== ( const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>& )
+    {
+        return true;
+    }
+
+    /**
+     * All AlignedAllocator's are interchangeable.
+     */
+    template <typename T, typename U, size_t A>
+    bool
+    operator!= ( const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>& )
+    {
+        return false;
+    }
+
+    /**
+     * Cache-line aligned vector.
+     */
+    typedef std::vector< int, AlignedAllocator<int> > AlignedIntVector;
+};
+
+#endif
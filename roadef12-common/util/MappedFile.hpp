@@ -0,0 +1,154 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_common_MAPPED_FILE_HPP
+#define __roadef12_common_MAPPED_FILE_HPP
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/service/ServiceExceptions.hpp"
+#include "roadef12-common/util/Util.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <string>
+#include <cstddef>
+///////////////////////////////////////////////////////////////////////////
+// POSIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/noncopyable.hpp>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Read-only memory mapping of a whole file. The mapping lives as
+     * long as the object does.
+     *
+     * @author daniperez
+     */
+    class MappedFile : private boost::noncopyable
+    {
+        public:
+
+            /**
+             * Constructor. Maps the given file.
+             *
+             * @param fileName File to map.
+             * @throw IOException if the file cannot be open or mapped.
+             */
+            MappedFile ( const char* fileName )
+            throw ( ROADEF12COMMON::IOException )
+                : _data ( NULL ), _size ( 0 )
+            {
+                Util::throwing_assert ( fileName != NULL );
+
+                int fd = ::open ( fileName, O_RDONLY );
+
+                if ( fd < 0 )
+                {
+                    throw ROADEF12COMMON::IOException
+                    (
+                        (
+                            std::string ( "'" ) + fileName +
+                            std::string ( "' cannot be open" )
+                        ).c_str()
+                    );
+                }
+
+                struct stat status;
+
+                bool ok = ( ::fstat ( fd, &status ) == 0 );
+
+                if ( ok && status.st_size > 0 )
+                {
+                    _size = status.st_size;
+
+                    void* address = ::mmap ( NULL, _size, PROT_READ,
+                                             MAP_PRIVATE, fd, 0 );
+
+                    ok = ( address != MAP_FAILED );
+
+                    if ( ok )
+                    {
+                        _data = static_cast<const char*> ( address );
+
+                        ::madvise ( address, _size, MADV_SEQUENTIAL );
+                    }
+                }
+
+                ::close ( fd );
+
+                if ( ! ok )
+                {
+                    throw ROADEF12COMMON::IOException
+                    (
+                        (std::string(fileName) +
+                            std::string (" cannot be mapped")).c_str()
+                    );
+                }
+            }
+
+            /**
+             * Destructor. Unmaps the file.
+             */
+            ~MappedFile ()
+            {
+                if ( _data != NULL )
+                {
+                    ::munmap ( const_cast<char*> ( _data ), _size );
+                }
+            }
+
+            /**
+             * First byte of the file. NULL if the file is empty.
+             *
+             * @return Pointer to the mapped content.
+             */
+            const char*
+            data () const
+            {
+                return _data;
+            }
+
+            /**
+             * Size of the file in bytes.
+             *
+             * @return Size of the mapped content.
+             */
+            size_t
+            size () const
+            {
+                return _size;
+            }
+
+        private:
+
+            const char* _data;
+            size_t      _size;
+    };
+};
+
+#endif
@@ -0,0 +1,119 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_common_VALUES_VIEW_HPP
+#define __roadef12_common_VALUES_VIEW_HPP
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <cstddef>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12COMMON
+{
+    /**
+     * Read-only view over a contiguous array of integers, being it a
+     * parsed std::vector or a memory-mapped compiled instance. The
+     * viewed memory must outlive the view.
+     *
+     * @author daniperez
+     */
+    class ValuesView
+    {
+        public:
+
+            /**
+             * Iterator type.
+             */
+            typedef const int* const_iterator;
+
+            /**
+             * Constructor. Views the content of a vector.
+             *
+             * @param values Vector to view.
+             */
+            ValuesView ( const std::vector<int>& values )
+                : _data ( values.empty() ? NULL : &values[0] ),
+                  _size ( values.size() )
+            {
+            }
+
+            /**
+             * Constructor. Views a raw array.
+             *
+             * @param data First integer.
+             * @param size Number of integers.
+             */
+            ValuesView ( const int* data, size_t size )
+                : _data ( data ), _size ( size )
+            {
+            }
+
+            /**
+             * Returns the i-th integer.
+             *
+             * @param i Index.
+             * @return Value.
+             */
+            const int&
+            operator[] ( size_t i ) const
+            {
+                return _data [ i ];
+            }
+
+            /**
+             * Number of integers.
+             *
+             * @return Size of the view.
+             */
+            size_t
+            size () const
+            {
+                return _size;
+            }
+
+            /**
+             * @return Iterator to the first integer.
+             */
+            const_iterator
+            begin () const
+            {
+                return _data;
+            }
+
+            /**
+             * @return Past-the-end iterator.
+             */
+            const_iterator
+            end () const
+            {
+                return _data + _size;
+            }
+
+        private:
+
+            const int* _data;
+            size_t     _size;
+    };
+};
+
+#endif
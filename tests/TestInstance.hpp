@@ -0,0 +1,127 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+#ifndef __roadef12_TEST_INSTANCE_HPP
+#define __roadef12_TEST_INSTANCE_HPP
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/noncopyable.hpp>
+#include <boost/lexical_cast.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/config.h"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <string>
+#include <vector>
+///////////////////////////////////////////////////////////////////////////
+
+namespace ROADEF12TESTS
+{
+    /**
+     * Path of a file of the material data.
+     *
+     * @param file Path relative to roadef12-material/data, e.g.
+     *        "data_a1/model_a1_1.txt".
+     * @return Absolute path.
+     */
+    inline std::string
+    getDataPath ( const std::string& file )
+    {
+        return std::string ( PROJECT_SOURCE_DIR ) + "/roadef12-material/data/" + file;
+    }
+
+    /**
+     * Instance of the material loaded for a test: the model values, the
+     * parameters viewing them and the initial assignment. Members are
+     * built in declaration order, so the values outlive the parameters
+     * and the parameters the assignment.
+     *
+     * @author daniperez
+     */
+    class TestInstance : boost::noncopyable
+    {
+        public:
+
+            /**
+             * Loads model_a1_<a1> and assignment_a1_<a1>.
+             *
+             * @param a1 Instance number, in [1, 5].
+             */
+            explicit TestInstance ( uint a1 )
+                : values ( parse ( getA1Path ( "model", a1 ) ) ),
+                  parameters ( values ),
+                  assignment ( getA1Path ( "assignment", a1 ).c_str(), parameters )
+            {
+            }
+
+            /**
+             * Loads any model and assignment of the material.
+             *
+             * @param model Model path relative to roadef12-material/data.
+             * @param initial Assignment path relative to roadef12-material/data.
+             */
+            TestInstance ( const std::string& model, const std::string& initial )
+                : values ( parse ( getDataPath ( model ) ) ),
+                  parameters ( values ),
+                  assignment ( getDataPath ( initial ).c_str(), parameters )
+            {
+            }
+
+        public:
+
+            /** Values of the model file. */
+            std::vector<int>           values;
+            /** Parameters, viewing values. */
+            ROADEF12COMMON::Parameters parameters;
+            /** Initial assignment. */
+            ROADEF12COMMON::Assignment assignment;
+
+        private:
+
+            /**
+             * Path of data_a1/<kind>_a1_<a1>.txt.
+             */
+            static std::string
+            getA1Path ( const char* kind, uint a1 )
+            {
+                return getDataPath ( std::string ( "data_a1/" ) + kind + "_a1_" +
+                                     boost::lexical_cast<std::string> ( a1 ) + ".txt" );
+            }
+
+            /**
+             * Values of the model file.
+             */
+            static std::vector<int>
+            parse ( const std::string& file )
+            {
+                std::vector<int> result;
+                ROADEF12COMMON::FileParser::parseVector ( file.c_str(), result );
+                return result;
+            }
+    };
+};
+
+#endif
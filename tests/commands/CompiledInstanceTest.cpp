@@ -0,0 +1,121 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/CompiledInstance.hpp"
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/config.h"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <cstdio>
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( CompiledInstanceRoundTrip )
+{
+    std::string model = std::string ( PROJECT_SOURCE_DIR ) +
+                        "/roadef12-material/data/data_a1/model_a1_2.txt";
+    std::string other = std::string ( PROJECT_SOURCE_DIR ) +
+                        "/roadef12-material/data/data_a1/model_a1_3.txt";
+    const char* cache = "CompiledInstanceTest.bin";
+
+    ROADEF12COMMON::CompiledInstance::compile ( model.c_str(), cache );
+
+    std::vector<int> expected;
+    ROADEF12COMMON::FileParser::parseVector ( model.c_str(), expected );
+
+    ROADEF12COMMON::CompiledInstance hit ( model.c_str(), cache );
+
+    BOOST_CHECK ( hit.isCached() );
+    BOOST_CHECK ( std::vector<int> ( hit.values().begin(),
+                                     hit.values().end() ) == expected );
+
+    // Cache compiled from another content must be ignored.
+    ROADEF12COMMON::CompiledInstance miss ( other.c_str(), cache );
+
+    BOOST_CHECK ( ! miss.isCached() );
+
+    std::remove ( cache );
+}
+
+BOOST_AUTO_TEST_CASE( CompiledInstanceLeavesMoveCostsOut )
+{
+    std::string model = std::string ( PROJECT_SOURCE_DIR ) +
+                        "/roadef12-material/data/data_a1/model_a1_2.txt";
+
+    std::vector<int> expected;
+    ROADEF12COMMON::FileParser::parseVector ( model.c_str(), expected );
+
+    ROADEF12COMMON::Parameters dense ( expected );
+
+    // No cache: parsed from the text, without the M x M move costs
+    ROADEF12COMMON::CompiledInstance instance ( model.c_str(),
+                                                "CompiledInstanceTest.none" );
+
+    BOOST_REQUIRE ( ! instance.isCached() );
+    BOOST_REQUIRE ( instance.getMoveCosts() );
+
+    const uint numMachines = dense.machines.size();
+
+    BOOST_CHECK_EQUAL ( instance.values().size(),
+                        expected.size() - numMachines*numMachines );
+
+    ROADEF12COMMON::Parameters compact ( instance.values(), instance.getMoveCosts() );
+
+    BOOST_REQUIRE_EQUAL ( compact.machines.size(), numMachines );
+    BOOST_REQUIRE_EQUAL ( compact.processes.size(), dense.processes.size() );
+    BOOST_REQUIRE_EQUAL ( compact.services.size(), dense.services.size() );
+
+    for ( uint m = 0 ; m < numMachines ; ++m )
+    {
+        BOOST_REQUIRE_EQUAL ( compact.machines.getLocation ( m ),
+                              dense.machines.getLocation ( m ) );
+        BOOST_REQUIRE_EQUAL ( compact.machines.getSafetyCapacity ( m, 1 ),
+                              dense.machines.getSafetyCapacity ( m, 1 ) );
+
+        for ( uint n = 0 ; n < numMachines ; ++n )
+        {
+            BOOST_REQUIRE_EQUAL ( compact.machines.getMovingCost ( m, n ),
+                                  dense.machines.getMovingCost ( m, n ) );
+        }
+    }
+
+    for ( uint p = 0 ; p < dense.processes.size() ; ++p )
+    {
+        BOOST_REQUIRE_EQUAL ( compact.processes.getService ( p ),
+                              dense.processes.getService ( p ) );
+        BOOST_REQUIRE_EQUAL ( compact.processes.getPMC ( p ),
+                              dense.processes.getPMC ( p ) );
+    }
+
+    BOOST_CHECK_EQUAL ( compact.costs.getMachineMoveCostWeight(),
+                        dense.costs.getMachineMoveCostWeight() );
+    BOOST_CHECK_EQUAL ( compact.costs.getBalanceCostWeight ( 0 ),
+                        dense.costs.getBalanceCostWeight ( 0 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/config.h"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <limits>
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( MappedParserMatchesStreamParser )
+{
+    const char* files[] = { "data_example/model_example.txt",
+                            "data_example/initial_solution_example.txt",
+                            "data_a1/model_a1_1.txt",
+                            "data_a1/model_a1_2.txt",
+                            "data_a1/model_a1_5.txt",
+                            "data_a1/assignment_a1_4.txt" };
+
+    for ( size_t i = 0 ; i < sizeof ( files ) / sizeof ( files[0] ) ; ++i )
+    {
+        std::string file = std::string ( PROJECT_SOURCE_DIR ) +
+                           "/roadef12-material/data/" + files[i];
+
+        std::vector<int> streamed;
+        std::vector<int> mapped;
+
+        ROADEF12COMMON::FileParser::parseVector ( file.c_str(), streamed );
+        ROADEF12COMMON::FileParser::parseVectorMapped ( file.c_str(), mapped );
+
+        BOOST_CHECK ( streamed == mapped );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( MappedParserRejectsGarbage )
+{
+    std::string file = std::string ( PROJECT_SOURCE_DIR ) +
+                       "/roadef12-material/README";
+
+    std::vector<int> values;
+
+    BOOST_CHECK_THROW (
+        ROADEF12COMMON::FileParser::parseVectorMapped ( file.c_str(), values ),
+        ROADEF12COMMON::ParseException
+    );
+}
+
+BOOST_AUTO_TEST_CASE( MappedParserRejectsOutOfRangeIntegers )
+{
+    std::vector<int> values;
+    std::string      limits ( "2147483647 -2147483648\n" );
+
+    ROADEF12COMMON::FileParser::parseBuffer ( limits.data(),
+                                              limits.data() + limits.size(),
+                                              values, "limits" );
+
+    BOOST_REQUIRE_EQUAL ( values.size(), 2u );
+    BOOST_CHECK_EQUAL ( values [ 0 ], std::numeric_limits<int>::max() );
+    BOOST_CHECK_EQUAL ( values [ 1 ], std::numeric_limits<int>::min() );
+
+    const char* texts [] = { "1 2147483648", "-2147483649 1", "99999999999999999999" };
+
+    for ( uint i = 0 ; i < 3 ; ++i )
+    {
+        std::string text ( texts [ i ] );
+
+        BOOST_CHECK_THROW (
+            ROADEF12COMMON::FileParser::parseBuffer ( text.data(),
+                                                      text.data() + text.size(),
+                                                      values, "text" ),
+            ROADEF12COMMON::ParseException
+        );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
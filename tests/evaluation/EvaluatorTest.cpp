@@ -0,0 +1,275 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/BatchEvaluator.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    /**
+     * Evaluates assignment_a1_<i> against itself.
+     */
+    int64_t
+    evaluateA1 ( uint a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Evaluator   evaluator ( instance.parameters );
+
+        return evaluator.evaluate ( instance.assignment ).total();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( EvaluatorMatchesCheckerOnA1 )
+{
+    // Values reported by the ROADEF checker
+    BOOST_CHECK_EQUAL ( evaluateA1 ( 1 ), 49528750 );
+    BOOST_CHECK_EQUAL ( evaluateA1 ( 2 ), 1061649570 );
+    BOOST_CHECK_EQUAL ( evaluateA1 ( 3 ), 583662270 );
+    BOOST_CHECK_EQUAL ( evaluateA1 ( 4 ), 632499600 );
+    BOOST_CHECK_EQUAL ( evaluateA1 ( 5 ), 782189690 );
+}
+
+BOOST_AUTO_TEST_CASE( EvaluatorMatchesCheckerOnExample )
+{
+    ROADEF12TESTS::TestInstance instance ( "data_example/model_example.txt",
+                                           "data_example/initial_solution_example.txt" );
+    ROADEF12COMMON::Parameters& params  = instance.parameters;
+    ROADEF12COMMON::Assignment& initial = instance.assignment;
+    ROADEF12COMMON::Assignment  solution
+        ( ROADEF12TESTS::getDataPath ( "data_example/new_solution_example.txt" ).c_str(),
+          params );
+
+    ROADEF12COMMON::Evaluator evaluator ( params );
+
+    BOOST_CHECK_EQUAL ( evaluator.evaluate ( initial, solution ).total(), 2411 );
+
+    // Same solution reached by moving from the initial one
+    ROADEF12COMMON::Assignment moved ( initial );
+
+    for ( uint p = 0 ; p < params.processes.size() ; ++p )
+    {
+        moved.move ( p, solution.getMachine ( p ) );
+    }
+
+    BOOST_CHECK_EQUAL ( evaluator.evaluate ( moved ).total(), 2411 );
+}
+
+BOOST_AUTO_TEST_CASE( EvaluatorDeltaShift )
+{
+    for ( uint a1 = 1 ; a1 <= 5 ; ++a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::Evaluator evaluator ( params );
+
+        int64_t cost = evaluator.evaluate ( assignment ).total();
+
+        for ( uint i = 0 ; i < 200 ; ++i )
+        {
+            uint process = ( i * 7919 ) % params.processes.size();
+            uint machine = ( i % 3 == 0 )
+                           ? assignment.getOriginalMachine ( process )
+                           : ( i * 104729 ) % params.machines.size();
+
+            int64_t delta = evaluator.deltaShift ( assignment, process, machine );
+
+            assignment.move ( process, machine );
+
+            int64_t newCost = evaluator.evaluate ( assignment ).total();
+
+            BOOST_REQUIRE_EQUAL ( delta, newCost - cost );
+
+            cost = newCost;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( EvaluatorDeltaSwap )
+{
+    for ( uint a1 = 1 ; a1 <= 5 ; ++a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::Evaluator evaluator ( params );
+
+        int64_t cost = evaluator.evaluate ( assignment ).total();
+
+        for ( uint i = 0 ; i < 200 ; ++i )
+        {
+            uint process1 = ( i * 7919 ) % params.processes.size();
+            uint process2 = ( i % 4 == 0 )
+                            // Same service, or swapping a recent swap back
+                            ? assignment.getProcessesPerService
+                                ( params.processes.getService ( process1 ) ) [ 0 ]
+                            : ( i * 104729 + 3 ) % params.processes.size();
+
+            int64_t delta = evaluator.deltaSwap ( assignment, process1, process2 );
+
+            assignment.swap ( process1, process2 );
+
+            int64_t newCost = evaluator.evaluate ( assignment ).total();
+
+            BOOST_REQUIRE_EQUAL ( delta, newCost - cost );
+
+            cost = newCost;
+
+            if ( i % 5 == 0 )
+            {
+                delta = evaluator.deltaSwap ( assignment, process2, process1 );
+
+                assignment.swap ( process2, process1 );
+
+                newCost = evaluator.evaluate ( assignment ).total();
+
+                BOOST_REQUIRE_EQUAL ( delta, newCost - cost );
+
+                cost = newCost;
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( BatchEvaluatorMatchesDeltaShift )
+{
+    for ( uint a1 = 1 ; a1 <= 5 ; ++a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::BatchEvaluator evaluator ( params );
+
+        // Some processes away from home
+        for ( uint i = 0 ; i < 50 ; ++i )
+        {
+            assignment.move ( ( i * 7919 ) % params.processes.size(),
+                              ( i * 104729 ) % params.machines.size() );
+        }
+
+        std::vector<int64_t> deltas ( params.processes.size() );
+
+        for ( uint i = 0 ; i < 20 ; ++i )
+        {
+            uint process = ( i * 7919 ) % params.processes.size();
+
+            evaluator.evaluateMachines ( assignment, process, &deltas[0] );
+
+            for ( uint m = 0 ; m < params.machines.size() ; ++m )
+            {
+                BOOST_REQUIRE_EQUAL ( deltas [ m ],
+                                      evaluator.deltaShift ( assignment, process, m ) );
+            }
+        }
+
+        for ( uint m = 0 ; m < params.machines.size() ; m += 7 )
+        {
+            uint service = ( m * 13 ) % params.services.size();
+            ROADEF12COMMON::ProcessRange processes
+                = ( m % 2 ) ? assignment.getProcessesPerMachine ( ( m + 1 ) %
+                                                                  params.machines.size() )
+                            : assignment.getProcessesPerService ( service );
+
+            evaluator.evaluateProcesses ( assignment, m, processes, &deltas[0] );
+
+            for ( uint i = 0 ; i < processes.size() ; ++i )
+            {
+                BOOST_REQUIRE_EQUAL ( deltas [ i ],
+                                      evaluator.deltaShift ( assignment,
+                                                             processes [ i ], m ) );
+            }
+        }
+    }
+
+    // Example model with huge capacities of the first balance resource
+    // and a large target: target*capacity no longer fits in 32 bits
+    {
+        std::vector<int> values;
+        ROADEF12COMMON::FileParser::parseVector
+            ( ROADEF12TESTS::getDataPath ( "data_example/model_example.txt" ).c_str(),
+              values );
+
+        const uint numResources = values [ 0 ];
+        const uint numMachines  = values [ 1 + 2*numResources ];
+        const uint machineSize  = 2 + 2*numResources + numMachines;
+
+        for ( uint m = 0 ; m < numMachines ; ++m )
+        {
+            values [ 2 + 2*numResources + m*machineSize + 2 ] = 3000000;
+        }
+
+        // Balance triple (r1, r2, target, weight) precedes the three weights
+        values [ values.size() - 5 ] = 1000;
+
+        ROADEF12COMMON::Parameters params ( values );
+        ROADEF12COMMON::Assignment assignment
+            ( ROADEF12TESTS::getDataPath
+                  ( "data_example/initial_solution_example.txt" ).c_str(), params );
+
+        ROADEF12COMMON::BatchEvaluator evaluator ( params );
+
+        std::vector<int64_t> deltas ( params.machines.size() );
+
+        for ( uint process = 0 ; process < params.processes.size() ; ++process )
+        {
+            evaluator.evaluateMachines ( assignment, process, &deltas[0] );
+
+            for ( uint m = 0 ; m < params.machines.size() ; ++m )
+            {
+                BOOST_REQUIRE_EQUAL ( deltas [ m ],
+                                      evaluator.deltaShift ( assignment, process, m ) );
+            }
+        }
+
+        for ( uint m = 0 ; m < params.machines.size() ; ++m )
+        {
+            ROADEF12COMMON::ProcessRange processes
+                = assignment.getProcessesPerMachine ( ( m + 1 ) % params.machines.size() );
+
+            evaluator.evaluateProcesses ( assignment, m, processes, &deltas[0] );
+
+            for ( uint i = 0 ; i < processes.size() ; ++i )
+            {
+                BOOST_REQUIRE_EQUAL ( deltas [ i ],
+                                      evaluator.deltaShift ( assignment,
+                                                             processes [ i ], m ) );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( FeasibilityOracleMatchesFullCheck )
+{
+    for ( uint a1 = 1 ; a1 <= 5 ; ++a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::FeasibilityOracle oracle ( params );
+
+        BOOST_REQUIRE ( oracle.isFeasible ( assignment ) );
+
+        uint accepted = 0;
+
+        for ( uint i = 0 ; i < 3000 ; ++i )
+        {
+            uint process = ( i * 7919 ) % params.processes.size();
+            uint machine = ( i % 4 == 0 )
+                           ? assignment.getOriginalMachine ( process )
+                           : ( i * 104729 ) % params.machines.size();
+
+            bool legal = oracle.canMove ( assignment, process, machine );
+
+            assignment.begin ();
+            assignment.move ( process, machine );
+
+            BOOST_REQUIRE_EQUAL ( legal, oracle.isFeasible ( assignment ) );
+
+            if ( legal )
+            {
+                assignment.commit ();
+                ++accepted;
+            }
+            else
+            {
+                assignment.rollback ();
+            }
+        }
+
+        BOOST_CHECK ( accepted > 0 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FeasibilityOracleSwapMatchesFullCheck )
+{
+    for ( uint a1 = 1 ; a1 <= 5 ; ++a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::FeasibilityOracle oracle ( params );
+
+        uint accepted = 0;
+
+        for ( uint i = 0 ; i < 3000 ; ++i )
+        {
+            uint process1 = ( i * 7919 ) % params.processes.size();
+            uint process2 = ( i * 104729 + 13 ) % params.processes.size();
+
+            assignment.begin ();
+            assignment.swap ( process1, process2 );
+
+            bool legal = oracle.keepsFeasibleAfterSwap ( assignment,
+                                                         process1, process2 );
+
+            BOOST_REQUIRE_EQUAL ( legal, oracle.isFeasible ( assignment ) );
+
+            if ( legal )
+            {
+                assignment.commit ();
+                ++accepted;
+            }
+            else
+            {
+                assignment.rollback ();
+            }
+        }
+
+        BOOST_CHECK ( accepted > 0 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,297 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <set>
+#include <map>
+#include <cstdio>
+#include <fstream>
+///////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    /**
+     * Recomputes loads, transient usage and locations per service from
+     * scratch and compares them with the incremental ones.
+     */
+    void
+    checkBookkeeping ( const ROADEF12COMMON::Parameters& params,
+                       const ROADEF12COMMON::Assignment& assignment )
+    {
+        const uint numResources = params.resources.size();
+
+        std::vector<uint> load ( params.machines.size()*numResources, 0 );
+        std::vector<uint> transient ( params.machines.size()*numResources, 0 );
+        std::vector< std::set<int> > locations ( params.services.size() );
+        std::vector< std::map<int, uint> > perLocation ( params.services.size() );
+        std::vector< std::map<int, uint> > perNeighborhood ( params.services.size() );
+
+        for ( uint p = 0 ; p < params.processes.size() ; ++p )
+        {
+            uint machine  = assignment.getMachine ( p );
+            uint original = assignment.getOriginalMachine ( p );
+
+            for ( uint r = 0 ; r < numResources ; ++r )
+            {
+                load [ machine*numResources + r ]
+                    += params.processes.getRequirement ( p, r );
+
+                if ( machine != original && params.resources.isTransient ( r ) )
+                {
+                    transient [ original*numResources + r ]
+                        += params.processes.getRequirement ( p, r );
+                }
+            }
+
+            const int service = params.processes.getService ( p );
+
+            locations [ service ].insert ( params.machines.getLocation ( machine ) );
+            ++perLocation [ service ] [ params.machines.getLocation ( machine ) ];
+            ++perNeighborhood [ service ] [ params.machines.getNeighborhood ( machine ) ];
+        }
+
+        uint numListed = 0;
+
+        for ( uint m = 0 ; m < params.machines.size() ; ++m )
+        {
+            BOOST_FOREACH ( ushort p, assignment.getProcessesPerMachine ( m ) )
+            {
+                BOOST_REQUIRE_EQUAL ( assignment.getMachine ( p ), m );
+                ++numListed;
+            }
+        }
+
+        BOOST_REQUIRE_EQUAL ( numListed, params.processes.size() );
+
+        numListed = 0;
+
+        for ( uint s = 0 ; s < params.services.size() ; ++s )
+        {
+            BOOST_FOREACH ( ushort p, assignment.getProcessesPerService ( s ) )
+            {
+                BOOST_REQUIRE_EQUAL ( params.processes.getService ( p ), (int) s );
+                ++numListed;
+            }
+        }
+
+        BOOST_REQUIRE_EQUAL ( numListed, params.processes.size() );
+
+        for ( uint m = 0 ; m < params.machines.size() ; ++m )
+        {
+            for ( uint r = 0 ; r < numResources ; ++r )
+            {
+                BOOST_REQUIRE_EQUAL ( assignment.getUtilization ( m, r ),
+                                      load [ m*numResources + r ] );
+                BOOST_REQUIRE_EQUAL ( assignment.getTransientUtilization ( m, r ),
+                                      transient [ m*numResources + r ] );
+                BOOST_REQUIRE_EQUAL ( assignment.getSlackIndex().getSlacks ( m ) [ r ],
+                                      params.machines.getCapacity ( m, r ) -
+                                      int ( load [ m*numResources + r ] ) -
+                                      int ( transient [ m*numResources + r ] ) );
+            }
+        }
+
+        for ( uint s = 0 ; s < params.services.size() ; ++s )
+        {
+            BOOST_REQUIRE_EQUAL ( assignment.getNumLocationsPerService ( s ),
+                                  locations [ s ].size() );
+
+            for ( uint l = 0 ; l < params.compiled.getNumLocations() ; ++l )
+            {
+                BOOST_REQUIRE_EQUAL ( assignment.getNumProcessesInLocation ( s, l ),
+                                      perLocation [ s ] [ l ] );
+            }
+
+            for ( uint n = 0 ; n < params.compiled.getNumNeighborhoods() ; ++n )
+            {
+                BOOST_REQUIRE_EQUAL ( assignment.getNumProcessesInNeighborhood ( s, n ),
+                                      perNeighborhood [ s ] [ n ] );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( AssignmentMoveBookkeeping )
+{
+    ROADEF12TESTS::TestInstance instance ( 2 );
+    ROADEF12COMMON::Parameters& params     = instance.parameters;
+    ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+    checkBookkeeping ( params, assignment );
+
+    for ( uint i = 0 ; i < 500 ; ++i )
+    {
+        uint process = ( i * 7919 ) % params.processes.size();
+        uint machine = ( i * 104729 ) % params.machines.size();
+
+        assignment.move ( process, machine );
+
+        BOOST_REQUIRE_EQUAL ( assignment.getMachine ( process ), machine );
+    }
+
+    checkBookkeeping ( params, assignment );
+
+    // Moving everything back releases all transient usage
+    for ( uint p = 0 ; p < params.processes.size() ; ++p )
+    {
+        assignment.move ( p, assignment.getOriginalMachine ( p ) );
+    }
+
+    checkBookkeeping ( params, assignment );
+
+    for ( uint m = 0 ; m < params.machines.size() ; ++m )
+    {
+        for ( uint r = 0 ; r < params.resources.size() ; ++r )
+        {
+            BOOST_REQUIRE_EQUAL ( assignment.getTransientUtilization ( m, r ), 0u );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( AssignmentSwapBookkeeping )
+{
+    ROADEF12TESTS::TestInstance instance ( 4 );
+    ROADEF12COMMON::Parameters& params     = instance.parameters;
+    ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+    for ( uint i = 0 ; i < 500 ; ++i )
+    {
+        uint process1 = ( i * 7919 ) % params.processes.size();
+        uint process2 = ( i * 104729 + 1 ) % params.processes.size();
+        uint machine1 = assignment.getMachine ( process1 );
+        uint machine2 = assignment.getMachine ( process2 );
+
+        assignment.swap ( process1, process2 );
+
+        BOOST_REQUIRE_EQUAL ( assignment.getMachine ( process1 ), machine2 );
+        BOOST_REQUIRE_EQUAL ( assignment.getMachine ( process2 ), machine1 );
+    }
+
+    checkBookkeeping ( params, assignment );
+}
+
+BOOST_AUTO_TEST_CASE( AssignmentRollback )
+{
+    ROADEF12TESTS::TestInstance instance ( 3 );
+    ROADEF12COMMON::Parameters& params     = instance.parameters;
+    ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+    // A committed transaction keeps its moves
+    assignment.begin ();
+    assignment.move ( 0, ( assignment.getMachine ( 0 ) + 1 ) %
+                         params.machines.size() );
+    assignment.commit ();
+
+    std::vector<ushort> committed;
+
+    for ( uint p = 0 ; p < params.processes.size() ; ++p )
+    {
+        committed.push_back ( assignment.getMachine ( p ) );
+    }
+
+    assignment.begin ();
+
+    for ( uint i = 0 ; i < 300 ; ++i )
+    {
+        uint process1 = ( i * 7919 ) % params.processes.size();
+        uint process2 = ( i * 104729 + 1 ) % params.processes.size();
+
+        if ( i % 2 )
+        {
+            assignment.swap ( process1, process2 );
+        }
+        else
+        {
+            assignment.move ( process1, i % params.machines.size() );
+        }
+    }
+
+    BOOST_CHECK ( assignment.inTransaction () );
+
+    assignment.rollback ();
+
+    BOOST_CHECK ( ! assignment.inTransaction () );
+
+    for ( uint p = 0 ; p < params.processes.size() ; ++p )
+    {
+        BOOST_REQUIRE_EQUAL ( assignment.getMachine ( p ), committed [ p ] );
+    }
+
+    checkBookkeeping ( params, assignment );
+}
+
+BOOST_AUTO_TEST_CASE( AssignmentCopy )
+{
+    ROADEF12TESTS::TestInstance instance ( 1 );
+    ROADEF12COMMON::Parameters& params   = instance.parameters;
+    ROADEF12COMMON::Assignment& original = instance.assignment;
+
+    ROADEF12COMMON::Assignment copy ( original );
+
+    ushort machine = original.getMachine ( 0 );
+
+    copy.move ( 0, ( machine + 1 ) % params.machines.size() );
+
+    BOOST_CHECK_EQUAL ( original.getMachine ( 0 ), machine );
+    checkBookkeeping ( params, original );
+    checkBookkeeping ( params, copy );
+
+    original = copy;
+
+    BOOST_CHECK_EQUAL ( original.getMachine ( 0 ), copy.getMachine ( 0 ) );
+    checkBookkeeping ( params, original );
+}
+
+BOOST_AUTO_TEST_CASE( AssignmentRejectsUnknownMachines )
+{
+    ROADEF12TESTS::TestInstance instance ( "data_example/model_example.txt",
+                                           "data_example/initial_solution_example.txt" );
+    ROADEF12COMMON::Parameters& params = instance.parameters;
+    const char*                 file   = "AssignmentRejectsUnknownMachines.txt";
+
+    // 4 machines: ids 4 and -1 don't exist
+    const char* contents [] = { "0 3 4", "-1 0 0" };
+
+    for ( uint i = 0 ; i < 2 ; ++i )
+    {
+        std::ofstream ( file ) << contents [ i ] << std::endl;
+
+        BOOST_CHECK_THROW ( ROADEF12COMMON::Assignment ( file, params ),
+                            ROADEF12COMMON::ParseException );
+    }
+
+    std::remove ( file );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
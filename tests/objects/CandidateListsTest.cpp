@@ -0,0 +1,141 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( CandidateListsMatchStaticFilters )
+{
+    for ( uint a1 = 1 ; a1 <= 5 ; ++a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        const ROADEF12COMMON::CompiledModel& model = params.compiled;
+
+        ROADEF12COMMON::CandidateLists serial ( params, 1 );
+        ROADEF12COMMON::CandidateLists parallel ( params, 4 );
+
+        BOOST_REQUIRE_EQUAL ( serial.size(), parallel.size() );
+
+        size_t total = 0;
+
+        for ( uint p = 0 ; p < params.processes.size() ; ++p )
+        {
+            ROADEF12COMMON::MachineRange candidates = serial.getCandidates ( p );
+            ROADEF12COMMON::MachineRange others     = parallel.getCandidates ( p );
+
+            BOOST_REQUIRE ( std::equal ( candidates.begin(), candidates.end(),
+                                         others.begin() ) );
+            BOOST_REQUIRE ( std::is_sorted ( candidates.begin(),
+                                             candidates.end() ) );
+
+            // The initial, feasible, machine passes the filters
+            BOOST_REQUIRE ( std::binary_search ( candidates.begin(),
+                                                 candidates.end(),
+                                                 assignment.getMachine ( p ) ) );
+
+            // Every machine is listed iff it passes both filters
+            for ( uint m = 0 ; m < params.machines.size() ; ++m )
+            {
+                bool fits = true;
+
+                for ( uint r = 0 ; r < params.resources.size() ; ++r )
+                {
+                    fits = fits && params.processes.getRequirement ( p, r ) <=
+                                   params.machines.getCapacity ( m, r );
+                }
+
+                bool expected
+                    = fits && serial.isAllowed ( model.getService ( p ),
+                                                 model.getNeighborhood ( m ) );
+
+                BOOST_REQUIRE_EQUAL ( expected,
+                                      std::binary_search ( candidates.begin(),
+                                                           candidates.end(),
+                                                           m ) );
+                BOOST_REQUIRE_EQUAL ( expected, serial.isCandidate ( p, m ) );
+            }
+
+            total += candidates.size();
+        }
+
+        BOOST_CHECK_EQUAL ( total, serial.size() );
+
+        // Neighborhoods used by the initial assignment are allowed
+        for ( uint p = 0 ; p < params.processes.size() ; ++p )
+        {
+            BOOST_REQUIRE ( serial.isAllowed
+                                ( model.getService ( p ),
+                                  model.getNeighborhood ( assignment.getMachine ( p ) ) ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( CandidateListsDropDependencyNeighborhoods )
+{
+    // Service 1 depends on service 0, whose process only fits on
+    // machine 0, so neighborhood 1 is ruled out for service 1
+    int model [] =
+    {
+        1, 0, 1,                        // 1 resource, not transient, w=1
+        3,                              // 3 machines
+        0, 0, 10, 10, 0, 1, 1,          //   n0, l0, C=10
+        1, 1,  5,  5, 1, 0, 1,          //   n1, l1, C=5
+        1, 2,  9,  9, 1, 1, 0,          //   n1, l2, C=9
+        2,                              // 2 services
+        1, 0,                           //   s0: spread 1, no dependency
+        1, 1, 0,                        //   s1: spread 1, depends on s0
+        2,                              // 2 processes
+        0, 10, 1,                       //   p0 in s0, R=10
+        1, 1, 1,                        //   p1 in s1, R=1
+        0,                              // no balance
+        1, 1, 1                         // weights
+    };
+
+    ROADEF12COMMON::Parameters params
+        ( ROADEF12COMMON::ValuesView ( model, sizeof ( model ) / sizeof ( int ) ) );
+
+    ROADEF12COMMON::CandidateLists lists ( params );
+
+    BOOST_REQUIRE_EQUAL ( lists.getCandidates ( 0 ).size(), 1u );
+    BOOST_CHECK_EQUAL ( lists.getCandidates ( 0 ) [ 0 ], 0 );
+
+    BOOST_CHECK ( lists.isAllowed ( 1, 0 ) );
+    BOOST_CHECK ( ! lists.isAllowed ( 1, 1 ) );
+    BOOST_REQUIRE_EQUAL ( lists.getCandidates ( 1 ).size(), 1u );
+    BOOST_CHECK_EQUAL ( lists.getCandidates ( 1 ) [ 0 ], 0 );
+    BOOST_CHECK_EQUAL ( lists.size(), 2u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,88 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/model/MoveCostMatrix.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    /**
+     * Checks get() and getRow() against a dense size x size matrix.
+     */
+    void
+    checkMatrix ( const std::vector<int>& dense, uint size )
+    {
+        ROADEF12COMMON::MoveCostMatrix matrix ( dense, 0, size, size );
+        std::vector<int> row ( size );
+
+        for ( uint m = 0 ; m < size ; ++m )
+        {
+            matrix.getRow ( m, &row[0] );
+
+            for ( uint n = 0 ; n < size ; ++n )
+            {
+                BOOST_REQUIRE_EQUAL ( matrix.get ( m, n ), dense [ m*size + n ] );
+                BOOST_REQUIRE_EQUAL ( row [ n ], dense [ m*size + n ] );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( MoveCostMatrixNarrowWithEscapes )
+{
+    const uint size = 40;
+    std::vector<int> dense ( size*size );
+
+    for ( uint i = 0 ; i < dense.size() ; ++i )
+    {
+        dense [ i ] = i % 7;
+    }
+
+    dense [ 3 ]  = 255;
+    dense [ 77 ] = 123456;
+
+    checkMatrix ( dense, size );
+}
+
+BOOST_AUTO_TEST_CASE( MoveCostMatrixWide )
+{
+    const uint size = 30;
+    std::vector<int> dense ( size*size );
+
+    for ( uint i = 0 ; i < dense.size() ; ++i )
+    {
+        dense [ i ] = ( i * 37 ) % 1000;
+    }
+
+    dense [ 5 ] = 70000;
+
+    checkMatrix ( dense, size );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/FileParser.hpp"
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/config.h"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( ParametersExampleLayout )
+{
+    std::string file = std::string ( PROJECT_SOURCE_DIR ) +
+                       "/roadef12-material/data/data_example/model_example.txt";
+
+    std::vector<int> values;
+    ROADEF12COMMON::FileParser::parseVector ( file.c_str(), values );
+
+    ROADEF12COMMON::Parameters params ( values );
+
+    BOOST_CHECK_EQUAL ( params.resources.size(), 2u );
+    BOOST_CHECK_EQUAL ( params.machines.size(), 4u );
+    BOOST_CHECK_EQUAL ( params.services.size(), 2u );
+    BOOST_CHECK_EQUAL ( params.processes.size(), 3u );
+    BOOST_CHECK_EQUAL ( params.costs.getNumObjectiveBalance(), 1u );
+
+    BOOST_CHECK_EQUAL ( params.costs.getLoadCostWeight ( 0 ), 100 );
+    BOOST_CHECK_EQUAL ( params.costs.getLoadCostWeight ( 1 ), 10 );
+
+    BOOST_CHECK_EQUAL ( params.machines.getCapacity ( 3, 1 ), 100 );
+    BOOST_CHECK_EQUAL ( params.machines.getSafetyCapacity ( 0, 1 ), 80 );
+    BOOST_CHECK_EQUAL ( params.machines.getMovingCost ( 2, 0 ), 4 );
+
+    BOOST_CHECK_EQUAL ( params.processes.getService ( 2 ), 1 );
+    BOOST_CHECK_EQUAL ( params.processes.getRequirement ( 1, 1 ), 20 );
+    BOOST_CHECK_EQUAL ( params.processes.getPMC ( 0 ), 1000 );
+
+    BOOST_CHECK_EQUAL ( params.services.getMinSpread ( 0 ), 2 );
+    BOOST_CHECK_EQUAL ( params.services.getDependencies ( 0 ).size(), 0u );
+    BOOST_REQUIRE_EQUAL ( params.services.getDependencies ( 1 ).size(), 1u );
+    BOOST_CHECK_EQUAL ( params.services.getDependencies ( 1 ) [ 0 ], 0 );
+    BOOST_REQUIRE_EQUAL ( params.services.getDependents ( 0 ).size(), 1u );
+    BOOST_CHECK_EQUAL ( params.services.getDependents ( 0 ) [ 0 ], 1 );
+    BOOST_CHECK_EQUAL ( params.services.getDependents ( 1 ).size(), 0u );
+
+    BOOST_CHECK_EQUAL ( params.costs.getObjectiveBalanceTarget ( 0 ), 20 );
+    BOOST_CHECK_EQUAL ( params.costs.getBalanceCostWeight ( 0 ), 10u );
+    BOOST_CHECK_EQUAL ( params.costs.getProcessMoveCostWeight(), 1u );
+    BOOST_CHECK_EQUAL ( params.costs.getServiceMoveCostWeight(), 10u );
+    BOOST_CHECK_EQUAL ( params.costs.getMachineMoveCostWeight(), 100u );
+}
+
+BOOST_AUTO_TEST_CASE( CompiledModelMatchesAccessors )
+{
+    std::string file = std::string ( PROJECT_SOURCE_DIR ) +
+                       "/roadef12-material/data/data_a1/model_a1_4.txt";
+
+    std::vector<int> values;
+    ROADEF12COMMON::FileParser::parseVector ( file.c_str(), values );
+
+    ROADEF12COMMON::Parameters params ( values );
+    const ROADEF12COMMON::CompiledModel& model = params.compiled;
+
+    BOOST_CHECK_EQUAL ( model.getResourceStride() % 16, 0u );
+    BOOST_CHECK_EQUAL ( reinterpret_cast<size_t>
+                            ( model.getRequirements ( 1 ) ) % 64, 0u );
+
+    for ( uint p = 0 ; p < params.processes.size() ; ++p )
+    {
+        BOOST_REQUIRE_EQUAL ( model.getService ( p ),
+                              params.processes.getService ( p ) );
+        BOOST_REQUIRE_EQUAL ( model.getPMC ( p ),
+                              params.processes.getPMC ( p ) );
+
+        for ( uint r = 0 ; r < params.resources.size() ; ++r )
+        {
+            BOOST_REQUIRE_EQUAL ( model.getRequirements ( p ) [ r ],
+                                  params.processes.getRequirement ( p, r ) );
+        }
+    }
+
+    for ( uint m = 0 ; m < params.machines.size() ; ++m )
+    {
+        BOOST_REQUIRE_EQUAL ( model.getLocation ( m ),
+                              params.machines.getLocation ( m ) );
+
+        for ( uint r = 0 ; r < params.resources.size() ; ++r )
+        {
+            BOOST_REQUIRE_EQUAL ( model.getSafetyCapacities ( m ) [ r ],
+                                  params.machines.getSafetyCapacity ( m, r ) );
+        }
+    }
+
+    BOOST_CHECK_EQUAL ( model.getNumLocations(), 50u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,79 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/ServiceMoveTracker.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( ServiceMoveTrackerMatchesScan )
+{
+    const uint numServices = 7;
+
+    ROADEF12COMMON::ServiceMoveTracker tracker ( numServices, 100 );
+    std::vector<int> counts ( numServices, 0 );
+
+    for ( uint i = 0 ; i < 2000 ; ++i )
+    {
+        uint service1 = ( i * 31 ) % numServices;
+        uint service2 = ( i * 17 + 3 ) % numServices;
+        int  moved1   = ( counts [ service1 ] == 0 ) ? 1 : int ( i % 3 ) - 1;
+        int  moved2   = ( counts [ service2 ] + ( service1 == service2 ? moved1 : 0 )
+                          <= 0 ) ? 1 : int ( ( i / 3 ) % 3 ) - 1;
+
+        // Maximum after the change, by scanning
+        std::vector<int> after ( counts );
+        after [ service1 ] += moved1;
+        after [ service2 ] += moved2;
+
+        BOOST_REQUIRE_EQUAL ( tracker.getMaxAfter ( service1, moved1,
+                                                    service2, moved2 ),
+                              uint ( *std::max_element ( after.begin(),
+                                                         after.end() ) ) );
+
+        // Keep counts small so that several services share the maximum
+        if ( *std::max_element ( after.begin(), after.end() ) > 4 )
+        {
+            continue;
+        }
+
+        if ( moved1 != 0 ) tracker.update ( service1, moved1 );
+        if ( moved2 != 0 ) tracker.update ( service2, moved2 );
+        counts = after;
+
+        BOOST_REQUIRE_EQUAL ( tracker.getMax (),
+                              uint ( *std::max_element ( counts.begin(),
+                                                         counts.end() ) ) );
+
+        for ( uint s = 0 ; s < numServices ; ++s )
+        {
+            BOOST_REQUIRE_EQUAL ( tracker.get ( s ), uint ( counts [ s ] ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/SlackIndex.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( SlackIndexBuckets )
+{
+    ROADEF12COMMON::SlackIndex index ( 4, 2 );
+
+    const int  capacities [] = { 100, 100 };
+    const uint kept [] = { 0, 0 };
+    const uint loads [ 4 ][ 2 ] = { { 0, 0 }, { 50, 90 }, { 99, 0 }, { 100, 100 } };
+
+    for ( uint m = 0 ; m < 4 ; ++m )
+    {
+        index.update ( m, capacities, loads [ m ], kept );
+    }
+
+    ushort output [ 4 ];
+
+    const int small [] = { 1, 1 };
+    BOOST_CHECK_EQUAL ( index.findFits ( small, output ), 3u );
+
+    const int wide [] = { 40, 5 };
+    BOOST_REQUIRE_EQUAL ( index.findFits ( wide, output ), 2u );
+    BOOST_CHECK_EQUAL ( std::min ( output [ 0 ], output [ 1 ] ), 0 );
+    BOOST_CHECK_EQUAL ( std::max ( output [ 0 ], output [ 1 ] ), 1 );
+
+    const int none [] = { 0, 0 };
+    BOOST_CHECK_EQUAL ( index.findFits ( none, output ), 4u );
+
+    // Machine 0 fills up: it changes bucket
+    const uint full [] = { 100, 100 };
+    index.update ( 0, capacities, full, kept );
+    BOOST_CHECK_EQUAL ( index.findFits ( wide, output ), 1u );
+    BOOST_CHECK_EQUAL ( index.findFits ( small, output ), 2u );
+}
+
+BOOST_AUTO_TEST_CASE( FittingMachinesMatchOracle )
+{
+    for ( uint a1 = 1 ; a1 <= 5 ; ++a1 )
+    {
+        ROADEF12TESTS::TestInstance instance ( a1 );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::FeasibilityOracle oracle ( params );
+
+        std::vector<ushort> output ( params.machines.size() );
+
+        for ( uint i = 0 ; i < 400 ; ++i )
+        {
+            uint process = ( i * 7919 ) % params.processes.size();
+
+            // Random, possibly infeasible, moves and swaps
+            if ( i % 3 == 0 )
+            {
+                assignment.move ( process, ( i * 104729 ) % params.machines.size() );
+            }
+            else if ( i % 3 == 1 )
+            {
+                assignment.swap ( process, ( i * 31 ) % params.processes.size() );
+            }
+
+            uint found = assignment.findFittingMachines ( process, &output[0] );
+
+            std::vector<bool> listed ( params.machines.size(), false );
+
+            for ( uint k = 0 ; k < found ; ++k )
+            {
+                BOOST_REQUIRE ( ! listed [ output [ k ] ] );
+                listed [ output [ k ] ] = true;
+            }
+
+            for ( uint m = 0 ; m < params.machines.size() ; ++m )
+            {
+                bool expected = m != assignment.getMachine ( process ) &&
+                                oracle.fitsCapacity ( assignment, process, m );
+
+                BOOST_REQUIRE_EQUAL ( listed [ m ], expected );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
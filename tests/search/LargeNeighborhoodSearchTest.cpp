@@ -0,0 +1,108 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/LargeNeighborhoodSearch.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( LargeNeighborhoodSearchOperatorsStayFeasible )
+{
+    const uint instances [] = { 1, 4 };
+
+    for ( uint i = 0 ; i < 2 ; ++i )
+    {
+        ROADEF12TESTS::TestInstance instance ( instances [ i ] );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::CandidateLists          candidates ( params );
+        ROADEF12COMMON::Evaluator               evaluator ( params );
+        ROADEF12COMMON::FeasibilityOracle       oracle ( params );
+        ROADEF12COMMON::LargeNeighborhoodSearch search ( params, candidates, 3 );
+
+        int64_t cost = evaluator.evaluate ( assignment ).total();
+
+        // Every kept iteration must be feasible and its delta exact
+        for ( int op = 0 ;
+              op < ROADEF12COMMON::LargeNeighborhoodSearch::NUM_OPERATORS ;
+              ++op )
+        {
+            for ( uint it = 0 ; it < 50 ; ++it )
+            {
+                const int64_t delta = search.iterate
+                    ( assignment,
+                      ROADEF12COMMON::LargeNeighborhoodSearch::Operator ( op ) );
+
+                BOOST_REQUIRE ( delta <= 0 );
+                BOOST_REQUIRE ( oracle.isFeasible ( assignment ) );
+
+                cost += delta;
+
+                BOOST_REQUIRE_EQUAL ( evaluator.evaluate ( assignment ).total(),
+                                      cost );
+            }
+        }
+
+        BOOST_CHECK_EQUAL ( search.getNumIterations(),
+                            50u*ROADEF12COMMON::LargeNeighborhoodSearch::NUM_OPERATORS );
+        BOOST_CHECK ( search.getNumImprovements() > 0 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( LargeNeighborhoodSearchImproves )
+{
+    ROADEF12TESTS::TestInstance instance ( 2 );
+    ROADEF12COMMON::Parameters& params     = instance.parameters;
+    ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+    ROADEF12COMMON::CandidateLists          candidates ( params );
+    ROADEF12COMMON::Evaluator               evaluator ( params );
+    ROADEF12COMMON::FeasibilityOracle       oracle ( params );
+    ROADEF12COMMON::LargeNeighborhoodSearch search ( params, candidates, 5 );
+
+    const int64_t cost = evaluator.evaluate ( assignment ).total();
+
+    const int64_t delta
+        = search.run ( assignment,
+                       ROADEF12COMMON::SearchClock::now() +
+                       std::chrono::milliseconds ( 300 ) );
+
+    BOOST_CHECK ( delta < 0 );
+    BOOST_CHECK ( oracle.isFeasible ( assignment ) );
+    BOOST_CHECK_EQUAL ( evaluator.evaluate ( assignment ).total(), cost + delta );
+    BOOST_CHECK ( search.getStatistics().applied > 0 );
+    BOOST_CHECK ( search.getDestroySize() >= 2 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/LocalSearch.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( LocalSearchImprovesAndStaysFeasible )
+{
+    const uint instances [] = { 1, 3 };
+
+    for ( uint i = 0 ; i < 2 ; ++i )
+    {
+        ROADEF12TESTS::TestInstance instance ( instances [ i ] );
+        ROADEF12COMMON::Parameters& params  = instance.parameters;
+        ROADEF12COMMON::Assignment& initial = instance.assignment;
+
+        ROADEF12COMMON::CandidateLists    candidates ( params );
+        ROADEF12COMMON::Evaluator         evaluator ( params );
+        ROADEF12COMMON::FeasibilityOracle oracle ( params );
+
+        const int64_t cost = evaluator.evaluate ( initial ).total();
+
+        for ( int best = 0 ; best <= 1 ; ++best )
+        {
+            ROADEF12COMMON::Assignment   assignment ( initial );
+            ROADEF12COMMON::LocalSearch  search ( params, candidates, 42 );
+
+            search.setBestImprovement ( best );
+
+            const int64_t delta
+                = search.run ( assignment,
+                               ROADEF12COMMON::SearchClock::now() +
+                               std::chrono::milliseconds ( 300 ) );
+
+            BOOST_CHECK ( delta < 0 );
+            BOOST_CHECK ( oracle.isFeasible ( assignment ) );
+            BOOST_CHECK_EQUAL ( evaluator.evaluate ( assignment ).total(),
+                                cost + delta );
+            BOOST_CHECK ( search.getStatistics().applied > 0 );
+            BOOST_CHECK ( search.getStatistics().evaluated >=
+                          search.getStatistics().applied );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( LocalSearchIsDeterministicPerSeed )
+{
+    ROADEF12TESTS::TestInstance instance ( 1 );
+    ROADEF12COMMON::Parameters& params  = instance.parameters;
+    ROADEF12COMMON::Assignment& initial = instance.assignment;
+
+    ROADEF12COMMON::CandidateLists candidates ( params );
+
+    ROADEF12COMMON::Assignment  first ( initial );
+    ROADEF12COMMON::Assignment  second ( initial );
+    ROADEF12COMMON::LocalSearch search1 ( params, candidates, 7 );
+    ROADEF12COMMON::LocalSearch search2 ( params, candidates, 7 );
+
+    // Far deadline: both stop at the same local optimum
+    ROADEF12COMMON::SearchClock::time_point deadline
+        = ROADEF12COMMON::SearchClock::now() + std::chrono::seconds ( 60 );
+
+    BOOST_CHECK_EQUAL ( search1.run ( first, deadline ),
+                        search2.run ( second, deadline ) );
+
+    for ( uint p = 0 ; p < params.processes.size() ; ++p )
+    {
+        BOOST_REQUIRE_EQUAL ( first.getMachine ( p ), second.getMachine ( p ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/LocalSearch.hpp"
+#include "roadef12-common/search/MultiStartSearch.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( MultiStartSearchBeatsSingleDescent )
+{
+    ROADEF12TESTS::TestInstance instance ( 1 );
+    ROADEF12COMMON::Parameters& params  = instance.parameters;
+    ROADEF12COMMON::Assignment& initial = instance.assignment;
+
+    ROADEF12COMMON::CandidateLists    candidates ( params );
+    ROADEF12COMMON::Evaluator         evaluator ( params );
+    ROADEF12COMMON::FeasibilityOracle oracle ( params );
+
+    const int64_t cost = evaluator.evaluate ( initial ).total();
+
+    // One descent from the input, to a local optimum
+    ROADEF12COMMON::Assignment  descended ( initial );
+    ROADEF12COMMON::LocalSearch search ( params, candidates, 3 );
+
+    const int64_t descent
+        = search.run ( descended,
+                       ROADEF12COMMON::SearchClock::now() + std::chrono::seconds ( 60 ) );
+
+    // Worker 0 starts with that same descent
+    ROADEF12COMMON::Assignment       assignment ( initial );
+    ROADEF12COMMON::MultiStartSearch multiStart ( params, candidates, 3, 3 );
+
+    const int64_t delta
+        = multiStart.run ( assignment,
+                           ROADEF12COMMON::SearchClock::now() +
+                           std::chrono::milliseconds ( 500 ) );
+
+    BOOST_CHECK ( delta <= descent );
+    BOOST_CHECK ( oracle.isFeasible ( assignment ) );
+    BOOST_CHECK_EQUAL ( evaluator.evaluate ( assignment ).total(), cost + delta );
+    BOOST_CHECK_EQUAL ( multiStart.getNumThreads(), 3u );
+    BOOST_CHECK ( multiStart.getNumTasks() >= 3u );
+    BOOST_CHECK ( multiStart.getStatistics().evaluated > 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/objects/CandidateLists.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/SimulatedAnnealing.hpp"
+#include "roadef12-common/search/XorShift.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( XorShiftIsUniformAndSeeded )
+{
+    ROADEF12COMMON::XorShift zero ( 0 );
+    ROADEF12COMMON::XorShift again ( 0 );
+    ROADEF12COMMON::XorShift other ( 1 );
+
+    BOOST_CHECK_EQUAL ( zero(), again() );
+    BOOST_CHECK ( again() != other() );
+
+    uint counts [ 10 ] = { 0 };
+
+    for ( uint i = 0 ; i < 100000 ; ++i )
+    {
+        const uint value = zero.below ( 10 );
+
+        BOOST_REQUIRE ( value < 10 );
+        ++counts [ value ];
+
+        const double real = zero.uniform();
+
+        BOOST_REQUIRE ( real >= 0 && real < 1 );
+    }
+
+    for ( uint i = 0 ; i < 10 ; ++i )
+    {
+        BOOST_CHECK ( counts [ i ] > 9500 && counts [ i ] < 10500 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SimulatedAnnealingImprovesAndStaysFeasible )
+{
+    const uint instances [] = { 2, 4 };
+
+    for ( uint i = 0 ; i < 2 ; ++i )
+    {
+        ROADEF12TESTS::TestInstance instance ( instances [ i ] );
+        ROADEF12COMMON::Parameters& params     = instance.parameters;
+        ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+        ROADEF12COMMON::CandidateLists     candidates ( params );
+        ROADEF12COMMON::Evaluator          evaluator ( params );
+        ROADEF12COMMON::FeasibilityOracle  oracle ( params );
+        ROADEF12COMMON::SimulatedAnnealing annealing ( params, candidates, 11 );
+
+        const int64_t cost = evaluator.evaluate ( assignment ).total();
+
+        const int64_t delta
+            = annealing.run ( assignment,
+                              ROADEF12COMMON::SearchClock::now() +
+                              std::chrono::milliseconds ( 400 ) );
+
+        BOOST_CHECK ( delta < 0 );
+        BOOST_CHECK ( oracle.isFeasible ( assignment ) );
+        BOOST_CHECK_EQUAL ( evaluator.evaluate ( assignment ).total(), cost + delta );
+
+        // Cools down to the final temperature as the deadline comes
+        BOOST_CHECK ( annealing.getInitialTemperature() >
+                      annealing.getFinalTemperature() );
+        BOOST_REQUIRE ( ! annealing.getTimeline().empty() );
+        BOOST_CHECK_CLOSE ( annealing.getTimeline().back().temperature,
+                            annealing.getFinalTemperature(), 1e-6 );
+
+        BOOST_CHECK ( annealing.getStatistics().applied > 0 );
+        BOOST_CHECK ( annealing.getStatistics().evaluated >
+                      annealing.getStatistics().applied );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,202 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/objects/Parameters.hpp"
+#include "roadef12-common/objects/Assignment.hpp"
+#include "roadef12-common/evaluation/Evaluator.hpp"
+#include "roadef12-common/evaluation/FeasibilityOracle.hpp"
+#include "roadef12-common/search/SubproblemSolver.hpp"
+#include "tests/TestInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <limits>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    /**
+     * Cheapest feasible cost over every reassignment of the processes of
+     * the machines among them.
+     */
+    int64_t
+    bruteForce ( const ROADEF12COMMON::Parameters& params,
+                 const ROADEF12COMMON::Assignment& initial,
+                 const std::vector<uint>& machines )
+    {
+        ROADEF12COMMON::Evaluator         evaluator ( params );
+        ROADEF12COMMON::FeasibilityOracle oracle ( params );
+        ROADEF12COMMON::Assignment        assignment ( initial );
+
+        std::vector<uint> processes;
+
+        for ( uint i = 0 ; i < machines.size() ; ++i )
+        {
+            const ROADEF12COMMON::ProcessRange range
+                = initial.getProcessesPerMachine ( machines [ i ] );
+
+            processes.insert ( processes.end(), range.begin(), range.end() );
+        }
+
+        std::vector<uint> digits ( processes.size(), 0 );
+        int64_t           best = std::numeric_limits<int64_t>::max();
+
+        for ( ; ; )
+        {
+            for ( uint j = 0 ; j < processes.size() ; ++j )
+            {
+                assignment.move ( processes [ j ], machines [ digits [ j ] ] );
+            }
+
+            if ( oracle.isFeasible ( assignment ) )
+            {
+                best = std::min ( best, evaluator.evaluate ( assignment ).total() );
+            }
+
+            uint j = 0;
+
+            while ( j < digits.size() && ++digits [ j ] == machines.size() )
+            {
+                digits [ j++ ] = 0;
+            }
+
+            if ( j == digits.size() )
+            {
+                return best;
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( SubproblemSolverMatchesBruteForce )
+{
+    // Subproblems of k machines and at most k^n <= 20000 reassignments
+    const char* models []      = { "data_example/model_example.txt",
+                                   "data_example/model_example.txt",
+                                   "data_a1/model_a1_2.txt" };
+    const char* assignments [] = { "data_example/initial_solution_example.txt",
+                                   "data_example/initial_solution_example.txt",
+                                   "data_a1/assignment_a1_2.txt" };
+    const uint  sizes []       = { 3, 4, 3 };
+    const uint  limits []      = { 9, 7, 9 };
+
+    for ( uint i = 0 ; i < 3 ; ++i )
+    {
+        ROADEF12TESTS::TestInstance instance ( models [ i ], assignments [ i ] );
+        ROADEF12COMMON::Parameters& params  = instance.parameters;
+        ROADEF12COMMON::Assignment& initial = instance.assignment;
+
+        ROADEF12COMMON::Evaluator         evaluator ( params );
+        ROADEF12COMMON::FeasibilityOracle oracle ( params );
+
+        {
+            // Least loaded machines, few enough processes to enumerate
+            std::vector< std::pair<uint, uint> > bySize;
+
+            for ( uint m = 0 ; m < params.machines.size() ; ++m )
+            {
+                bySize.push_back ( std::make_pair
+                                       ( initial.getProcessesPerMachine ( m ).size(), m ) );
+            }
+
+            std::sort ( bySize.begin(), bySize.end() );
+
+            std::vector<uint> group;
+            uint              numProcesses = 0;
+
+            for ( uint c = 0 ; c < bySize.size() && group.size() < sizes [ i ] ; ++c )
+            {
+                if ( numProcesses + bySize [ c ].first <= limits [ i ] )
+                {
+                    group.push_back ( bySize [ c ].second );
+                    numProcesses += bySize [ c ].first;
+                }
+            }
+
+            BOOST_REQUIRE_EQUAL ( group.size(), sizes [ i ] );
+
+            ROADEF12COMMON::Assignment       assignment ( initial );
+            ROADEF12COMMON::SubproblemSolver solver ( params );
+
+            const int64_t cost  = evaluator.evaluate ( initial ).total();
+            const int64_t delta = solver.solve ( assignment, &group[0], group.size(),
+                                                 ROADEF12COMMON::SearchClock::now() +
+                                                 std::chrono::seconds ( 60 ) );
+
+            BOOST_CHECK ( solver.isOptimal() );
+            BOOST_CHECK ( delta <= 0 );
+            BOOST_CHECK ( oracle.isFeasible ( assignment ) );
+            BOOST_CHECK_EQUAL ( evaluator.evaluate ( assignment ).total(), cost + delta );
+            BOOST_CHECK_EQUAL ( cost + delta, bruteForce ( params, initial, group ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SubproblemSolverKeepsFeasibleUnderBudget )
+{
+    ROADEF12TESTS::TestInstance instance ( 1 );
+    ROADEF12COMMON::Parameters& params     = instance.parameters;
+    ROADEF12COMMON::Assignment& assignment = instance.assignment;
+
+    ROADEF12COMMON::Evaluator         evaluator ( params );
+    ROADEF12COMMON::FeasibilityOracle oracle ( params );
+    ROADEF12COMMON::SubproblemSolver  solver ( params );
+
+    solver.setNodeLimit ( 20000 );
+
+    int64_t cost = evaluator.evaluate ( assignment ).total();
+
+    // Every group of 3 of the 4 machines, 100 processes: budget bound
+    for ( uint skip = 0 ; skip < 4 ; ++skip )
+    {
+        std::vector<uint> group;
+
+        for ( uint m = 0 ; m < 4 ; ++m )
+        {
+            if ( m != skip )
+            {
+                group.push_back ( m );
+            }
+        }
+
+        const int64_t delta = solver.solve ( assignment, &group[0], group.size(),
+                                             ROADEF12COMMON::SearchClock::now() +
+                                             std::chrono::seconds ( 60 ) );
+
+        BOOST_CHECK ( delta <= 0 );
+        BOOST_CHECK ( solver.getNumNodes() <= 20000u );
+        BOOST_REQUIRE ( oracle.isFeasible ( assignment ) );
+
+        cost += delta;
+
+        BOOST_REQUIRE_EQUAL ( evaluator.evaluate ( assignment ).total(), cost );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
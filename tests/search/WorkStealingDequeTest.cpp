@@ -0,0 +1,147 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// BOOST
+#include <boost/test/unit_test.hpp>
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/search/WorkStealingDeque.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+///////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( MainTestSuite )
+
+BOOST_AUTO_TEST_CASE( WorkStealingDequeEnds )
+{
+    ROADEF12COMMON::WorkStealingDeque<int> deque;
+
+    for ( int i = 0 ; i < 4 ; ++i )
+    {
+        deque.push ( i );
+    }
+
+    int task = -1;
+
+    BOOST_REQUIRE ( deque.pop ( task ) );
+    BOOST_CHECK_EQUAL ( task, 3 );
+    BOOST_REQUIRE ( deque.steal ( task ) );
+    BOOST_CHECK_EQUAL ( task, 0 );
+    BOOST_CHECK_EQUAL ( deque.size(), 2u );
+    BOOST_REQUIRE ( deque.pop ( task ) );
+    BOOST_REQUIRE ( deque.pop ( task ) );
+    BOOST_CHECK_EQUAL ( task, 1 );
+    BOOST_CHECK ( ! deque.pop ( task ) );
+    BOOST_CHECK ( ! deque.steal ( task ) );
+}
+
+namespace
+{
+    void
+    stealAll ( ROADEF12COMMON::WorkStealingDeque<int>* deque,
+               std::vector<int>* stolen,
+               const std::atomic<bool>* done )
+    {
+        int task;
+
+        while ( true )
+        {
+            if ( deque->steal ( task ) )
+            {
+                stolen->push_back ( task );
+            }
+            else if ( *done )
+            {
+                break;
+            }
+            else
+            {
+                std::this_thread::yield ();
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( WorkStealingDequeConcurrentSteals )
+{
+    const int total = 20000;
+
+    ROADEF12COMMON::WorkStealingDeque<int> deque;
+
+    std::vector<int> taken [ 4 ];
+    std::vector<std::thread> thieves;
+    std::atomic<bool> done ( false );
+
+    for ( int t = 1 ; t < 4 ; ++t )
+    {
+        thieves.push_back ( std::thread ( stealAll, &deque, &taken [ t ], &done ) );
+    }
+
+    int task;
+
+    for ( int i = 0 ; i < total ; ++i )
+    {
+        deque.push ( i );
+
+        if ( i % 3 == 0 && deque.pop ( task ) )
+        {
+            taken [ 0 ].push_back ( task );
+        }
+    }
+
+    while ( deque.pop ( task ) )
+    {
+        taken [ 0 ].push_back ( task );
+    }
+
+    // The owner emptied its deque: thieves stop when they fail to steal
+    done = true;
+
+    for ( uint t = 0 ; t < thieves.size() ; ++t )
+    {
+        thieves [ t ].join();
+    }
+
+    std::vector<int> all;
+
+    for ( int t = 0 ; t < 4 ; ++t )
+    {
+        all.insert ( all.end(), taken [ t ].begin(), taken [ t ].end() );
+    }
+
+    std::sort ( all.begin(), all.end() );
+
+    // Every task exactly once
+    BOOST_REQUIRE_EQUAL ( all.size(), size_t ( total ) );
+
+    for ( int i = 0 ; i < total ; ++i )
+    {
+        BOOST_REQUIRE_EQUAL ( all [ i ], i );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+// The MIT License
+// 
+// Copyright (c) 2011 daniperez
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+// 
+///////////////////////////////////////////////////////////////////////////
+// roadef12
+#include "roadef12-common/commands/CompiledInstance.hpp"
+///////////////////////////////////////////////////////////////////////////
+// STD
+#include <iostream>
+#include <cstdlib>
+///////////////////////////////////////////////////////////////////////////
+
+/**
+ * Compiles text models into the binary form Service maps at start-up.
+ *
+ * Usage: roadef12-compile model_file [compiled_file]
+ *
+ * compiled_file defaults to "model_file.bin", which is where Service
+ * looks for it.
+ */
+int main ( int argc, char** argv )
+{
+    int status = EXIT_FAILURE;
+
+    if ( argc != 2 && argc != 3 )
+    {
+        std::cerr << argv[0] << " model_file [compiled_file]" << std::endl;
+    }
+    else
+    {
+        std::string output
+            = ( argc == 3 ) ?
+              std::string ( argv[2] ) :
+              ROADEF12COMMON::CompiledInstance::getCacheFileName ( argv[1] );
+
+        try
+        {
+            ROADEF12COMMON::CompiledInstance::compile ( argv[1],
+                                                        output.c_str() );
+
+            std::cout << argv[1] << " -> " << output << std::endl;
+
+            status = EXIT_SUCCESS;
+        }
+        catch ( std::exception& e )
+        {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    return status;
+}